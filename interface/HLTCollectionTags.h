@@ -0,0 +1,76 @@
+#ifndef HLTCollectionTags_h
+#define HLTCollectionTags_h
+
+/** \class HLTCollectionTags
+ *
+ *
+ *  InputTags of the collections the Refs of an HLT filter point to, as
+ *  recorded by the HLTDoublet, HLTDoubletDZ and HLTTriplet filters with saveTags.
+ *
+ *  The provenance of a product does not change within a process history,
+ *  so the InputTag of each ProductID is looked up once and then cached,
+ *  until the process history of the events changes; the products seen
+ *  by a filter are few, so they are kept in small flat lists.
+ *
+ *  \author Martin Grunewald
+ *
+ */
+
+#include <vector>
+#include <utility>
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "DataFormats/Provenance/interface/ProductID.h"
+#include "DataFormats/Provenance/interface/ProcessHistoryID.h"
+#include "DataFormats/Provenance/interface/Provenance.h"
+
+//
+// class declaration
+//
+
+class HLTCollectionTags {
+
+   public:
+      HLTCollectionTags() :
+        history_(),
+        cache_()
+      { }
+
+      /// InputTag of the product with the given id
+      const edm::InputTag & tag(const edm::Event & event, const edm::ProductID & id) {
+        if (event.processHistoryID() != history_) {
+          history_ = event.processHistoryID();
+          cache_.clear();
+        }
+        for (unsigned int i=0; i!=cache_.size(); ++i)
+          if (cache_[i].first == id)
+            return cache_[i].second;
+
+        const edm::Provenance & provenance(event.getProvenance(id));
+        cache_.push_back(std::make_pair(id, edm::InputTag(provenance.moduleLabel(), provenance.productInstanceName(), provenance.processName())));
+        return cache_.back().second;
+      }
+
+      /// InputTags of the products the Refs point to, one per run of consecutive Refs to the same collection
+      template<typename R>
+      void tags(const edm::Event & event, const std::vector<R> & refs, std::vector<edm::InputTag> & tags) {
+        tags.clear();
+        edm::ProductID previous;
+        for (unsigned int i=0; i!=refs.size(); ++i) {
+          const edm::ProductID id(refs[i].id());
+          if (i!=0 and id == previous)
+            continue;
+          previous = id;
+          const edm::InputTag & current(tag(event, id));
+          if (tags.empty() or not (tags.back() == current))
+            tags.push_back(current);
+        }
+      }
+
+   private:
+      edm::ProcessHistoryID history_;                                   // process history the cache is valid for
+      std::vector<std::pair<edm::ProductID, edm::InputTag> > cache_;   // InputTag of each product seen so far
+};
+
+#endif // HLTCollectionTags_h
@@ -0,0 +1,110 @@
+#ifndef HLTCutAccessors_h
+#define HLTCutAccessors_h
+
+/** \class HLTCutAccessors
+ *
+ *
+ *  Accessors of the methods of T that can be used in a compiled string
+ *  cut, see HLTCutSelector: find returns a function calling the method
+ *  with the given name, or 0 if the method is not supported.
+ *
+ *  By default, the methods of the reco::Candidate interface are used;
+ *  trigger::TriggerObject has its own, smaller, interface.
+ *
+ *  \author Martin Grunewald
+ *
+ */
+
+#include <string>
+
+#include "DataFormats/HLTReco/interface/TriggerObject.h"
+
+//
+// by default, the methods of the reco::Candidate interface
+//
+
+template<typename T>
+struct HLTCutAccessors {
+  typedef double (*Accessor)(const T &);
+
+  static Accessor find(const std::string & name) {
+    if (name == "energy")    return & energy;
+    if (name == "et")        return & et;
+    if (name == "mass")      return & mass;
+    if (name == "massSqr")   return & massSqr;
+    if (name == "mt")        return & mt;
+    if (name == "p")         return & p;
+    if (name == "pt")        return & pt;
+    if (name == "px")        return & px;
+    if (name == "py")        return & py;
+    if (name == "pz")        return & pz;
+    if (name == "eta")       return & eta;
+    if (name == "phi")       return & phi;
+    if (name == "theta")     return & theta;
+    if (name == "rapidity")  return & rapidity;
+    if (name == "y")         return & rapidity;
+    if (name == "charge")    return & charge;
+    if (name == "pdgId")     return & pdgId;
+    if (name == "vx")        return & vx;
+    if (name == "vy")        return & vy;
+    if (name == "vz")        return & vz;
+    return 0;
+  }
+
+private:
+  static double energy  (const T & object) { return object.energy();   }
+  static double et      (const T & object) { return object.et();       }
+  static double mass    (const T & object) { return object.mass();     }
+  static double massSqr (const T & object) { return object.massSqr();  }
+  static double mt      (const T & object) { return object.mt();       }
+  static double p       (const T & object) { return object.p();        }
+  static double pt      (const T & object) { return object.pt();       }
+  static double px      (const T & object) { return object.px();       }
+  static double py      (const T & object) { return object.py();       }
+  static double pz      (const T & object) { return object.pz();       }
+  static double eta     (const T & object) { return object.eta();      }
+  static double phi     (const T & object) { return object.phi();      }
+  static double theta   (const T & object) { return object.theta();    }
+  static double rapidity(const T & object) { return object.rapidity(); }
+  static double charge  (const T & object) { return object.charge();   }
+  static double pdgId   (const T & object) { return object.pdgId();    }
+  static double vx      (const T & object) { return object.vx();       }
+  static double vy      (const T & object) { return object.vy();       }
+  static double vz      (const T & object) { return object.vz();       }
+};
+
+// specialize for type trigger::TriggerObject
+template<>
+struct HLTCutAccessors<trigger::TriggerObject> {
+  typedef double (*Accessor)(const trigger::TriggerObject &);
+
+  static Accessor find(const std::string & name) {
+    if (name == "id")        return & id;
+    if (name == "energy")    return & energy;
+    if (name == "et")        return & et;
+    if (name == "mass")      return & mass;
+    if (name == "p")         return & p;
+    if (name == "pt")        return & pt;
+    if (name == "px")        return & px;
+    if (name == "py")        return & py;
+    if (name == "pz")        return & pz;
+    if (name == "eta")       return & eta;
+    if (name == "phi")       return & phi;
+    return 0;
+  }
+
+private:
+  static double id      (const trigger::TriggerObject & object) { return object.id();       }
+  static double energy  (const trigger::TriggerObject & object) { return object.energy();   }
+  static double et      (const trigger::TriggerObject & object) { return object.et();       }
+  static double mass    (const trigger::TriggerObject & object) { return object.mass();     }
+  static double p       (const trigger::TriggerObject & object) { return object.p();        }
+  static double pt      (const trigger::TriggerObject & object) { return object.pt();       }
+  static double px      (const trigger::TriggerObject & object) { return object.px();       }
+  static double py      (const trigger::TriggerObject & object) { return object.py();       }
+  static double pz      (const trigger::TriggerObject & object) { return object.pz();       }
+  static double eta     (const trigger::TriggerObject & object) { return object.eta();      }
+  static double phi     (const trigger::TriggerObject & object) { return object.phi();      }
+};
+
+#endif // HLTCutAccessors_h
@@ -0,0 +1,80 @@
+#ifndef HLTCutColumns_h
+#define HLTCutColumns_h
+
+/** \class HLTCutColumns
+ *
+ *
+ *  Columnar view of a collection of objects of type T, for the compiled
+ *  string cuts of HLTCutSelector: the values of each accessor used by a
+ *  cut are filled the first time they are asked for, for all the objects
+ *  of the collection at once, and stored contiguously.
+ *
+ *  A module keeps its own view, and binds it to the collection of the
+ *  current event with reset(), which drops the columns of the previous
+ *  event; all the cuts evaluated by the module in the same event share
+ *  the columns, so that each of them is filled at most once per event.
+ *
+ *  \author Martin Grunewald
+ *
+ */
+
+#include <vector>
+#include <map>
+#include <utility>
+
+#include "HLTrigger/HLTfilters/interface/HLTCutAccessors.h"
+
+//
+// class declaration
+//
+
+template<typename T>
+class HLTCutColumns {
+
+   public:
+      typedef typename HLTCutAccessors<T>::Accessor Accessor;
+
+      HLTCutColumns() :
+        objects_(0),
+        columns_()
+      { }
+
+      explicit HLTCutColumns(const std::vector<T> & objects) :
+        objects_(& objects),
+        columns_()
+      { }
+
+      /// bind the view to a new collection of objects, dropping the columns filled so far
+      void reset(const std::vector<T> & objects) {
+        objects_ = & objects;
+        columns_.clear();
+      }
+
+      /// the objects
+      const std::vector<T> & objects() const {
+        return * objects_;
+      }
+
+      /// number of objects
+      unsigned int size() const {
+        return objects_->size();
+      }
+
+      /// values of the accessor for all the objects, or 0 if there are none
+      const double * column(Accessor accessor) const {
+        typename std::map<Accessor, std::vector<double> >::iterator i = columns_.find(accessor);
+        if (i == columns_.end()) {
+          i = columns_.insert(std::make_pair(accessor, std::vector<double>(objects_->size()))).first;
+          std::vector<double> & column = i->second;
+          for (unsigned int k=0; k!=column.size(); ++k)
+            column[k] = (*accessor)((*objects_)[k]);
+        }
+        return i->second.empty() ? 0 : & i->second.front();
+      }
+
+   private:
+      const std::vector<T> * objects_;                               // the objects
+      mutable std::map<Accessor, std::vector<double> > columns_;     // values of the accessors used so far
+};
+
+#endif // HLTCutColumns_h
@@ -0,0 +1,143 @@
+#ifndef HLTCutExpression_h
+#define HLTCutExpression_h
+
+/** \class HLTCutExpression
+ *
+ *
+ *  Compiles a string cut, such as "pt>15 && -3<eta<3", into a flat
+ *  program for a small stack machine, independent of the type of the
+ *  objects it is applied to: the variables (e.g. "pt", "eta") are only
+ *  collected by name, and their values are supplied by the caller for
+ *  each object, see HLTCutSelector.
+ *
+ *  The grammar covers the common subset of the StringCutObjectSelector
+ *  one: numbers and variables (optionally followed by "()"), unary and
+ *  binary + - * / ^ (all left-associative, e.g. 2^3^2 is 64, and -2^2 is
+ *  4 as the unary operators bind tighter than ^), the functions abs, sqrt, exp, log, log10, sin, cos,
+ *  tan, asin, acos, atan, sinh, cosh, tanh, atan2, hypot, min, max and
+ *  pow, the comparisons < <= > >= == != (also trinary, as in -3<eta<3),
+ *  and the logical operators !, && (or &) and || (or |), with the usual
+ *  precedence; a numerical value used as a condition is true if it is
+ *  not 0, and an empty cut accepts everything.
+ *
+ *  Anything else (e.g. methods with arguments, or chained methods) makes
+ *  the compilation fail, so that the caller can fall back to the full
+ *  StringCutObjectSelector.
+ *
+ *  The cut can be evaluated either for a single object, or for a whole
+ *  collection at once, given one column of values per variable: in the
+ *  latter case each instruction is applied to all the objects in a tight
+ *  loop, and constant operands are kept as scalars.
+ *
+ *  \author Martin Grunewald
+ *
+ */
+
+#include <vector>
+#include <string>
+
+//
+// class declaration
+//
+
+class HLTCutExpression {
+
+   public:
+      /// maximum number of variables and depth of the stack supported
+      static const unsigned int kMaxVariables = 16;
+      static const unsigned int kMaxDepth     = 32;
+
+      typedef std::vector<std::vector<double> > Columns;
+
+      /// buffers used to evaluate the cut on a whole collection, owned by the caller so that the expression can be shared
+      struct Workspace {
+        Columns variables;    // values of each variable, for all the objects, if they need to be gathered
+        Columns stack;        // intermediate results
+      };
+
+      explicit HLTCutExpression(const std::string & cut);
+
+      /// the cut without leading and trailing whitespace, and with each other run of whitespace outside quotes replaced by a single space
+      static std::string normalize(const std::string & cut);
+
+      /// true if the cut could be compiled
+      bool valid() const {
+        return valid_;
+      }
+
+      /// names of the variables used by the cut, in the order their values are expected
+      const std::vector<std::string> & variables() const {
+        return variables_;
+      }
+
+      /// evaluate the cut, given the values of the variables for one object
+      bool operator()(const double * values) const;
+
+      /// evaluate the cut on size objects, given the values of each variable in a column of at least size elements
+      void operator()(const double * const * columns, unsigned int size, Workspace & workspace, std::vector<unsigned char> & pass) const;
+
+   private:
+      enum Operation {
+        kConstant, kVariable,
+        kNegate, kNot,
+        kAdd, kSubtract, kMultiply, kDivide, kPower,
+        kLess, kLessEqual, kGreater, kGreaterEqual, kEqual, kNotEqual,
+        kAnd, kOr,
+        kAbs, kSqrt, kExp, kLog, kLog10, kSin, kCos, kTan, kAsin, kAcos, kAtan, kSinh, kCosh, kTanh,
+        kAtan2, kHypot, kMin, kMax
+      };
+
+      struct Instruction {
+        Instruction(Operation operation, double value = 0., unsigned int index = 0) :
+          operation(operation), value(value), index(index)
+        { }
+
+        Operation    operation;
+        double       value;     // value of a constant
+        unsigned int index;     // index of a variable
+      };
+
+      typedef std::vector<Instruction> Program;
+
+      // an entry of the stack used to evaluate the cut on a whole collection:
+      // either a constant, or a column of values, possibly held in one of the workspace buffers
+      struct Slot {
+        const double * data;    // values, or 0 for a constant
+        double         value;   // value of a constant
+        int            buffer;  // workspace buffer holding the values, or -1
+      };
+
+      // recursive descent parser, emitting the instructions in postfix order
+      bool parseOr        (Program & program);
+      bool parseAnd       (Program & program);
+      bool parseNot       (Program & program);
+      bool parseComparison(Program & program);
+      bool parseSum       (Program & program);
+      bool parseProduct   (Program & program);
+      bool parsePower     (Program & program);
+      bool parseUnary     (Program & program);
+      bool parsePrimary   (Program & program);
+
+      // lexical helpers
+      void skipSpaces();
+      bool accept(const char * token);
+      bool parseNumber(double & value);
+      bool parseIdentifier(std::string & name);
+
+      // index of a variable, adding it if needed
+      unsigned int variable(const std::string & name);
+
+      // true for the unary operators and functions
+      static bool isUnary(Operation operation);
+
+      // check the stack usage of the program
+      bool checkDepth() const;
+
+      std::string cut_;                     // the cut being compiled
+      std::string::size_type position_;     // current parsing position
+      bool valid_;                          // true if the cut was compiled
+      Program program_;                     // compiled program
+      std::vector<std::string> variables_;  // names of the variables used
+};
+
+#endif // HLTCutExpression_h
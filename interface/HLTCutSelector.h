@@ -0,0 +1,174 @@
+#ifndef HLTCutSelector_h
+#define HLTCutSelector_h
+
+/** \class HLTCutSelector
+ *
+ *
+ *  Selects objects of type T with a string cut, such as "pt>15 && -3<eta<3".
+ *
+ *  The cut is compiled by HLTCutExpression, and its variables are bound
+ *  to direct calls of the corresponding methods of T, as listed by the
+ *  HLTCutAccessors<T> traits; if the cut cannot be compiled, or it uses
+ *  a method not listed there, the whole cut is evaluated by a
+ *  StringCutObjectSelector<T,true> instead, with identical results.
+ *
+ *  A compiled cut can also be evaluated on a whole collection at once:
+ *  only the variables used by the cut are gathered into one contiguous
+ *  column each, and the cut is evaluated on all of them, see
+ *  HLTCutExpression; the buffers are provided by the caller. The columns
+ *  may also be taken from an HLTCutColumns view of the collection, shared
+ *  by all the selectors looking at it, for a range of objects or for the
+ *  objects at given indices.
+ *
+ *  Selectors are immutable, and shared: HLTCutSelector<T>::get returns
+ *  the selector for a cut from a process-wide cache, keyed by the type T
+ *  and by the cut with its whitespace normalised, so that a cut used by
+ *  many modules is parsed and held in memory only once; the selector is
+ *  built from the cut as first configured, not from the normalised key.
+ *
+ *  \author Martin Grunewald
+ *
+ */
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <map>
+#include <boost/shared_ptr.hpp>
+
+#include "CommonTools/Utils/interface/StringCutObjectSelector.h"
+#include "HLTrigger/HLTfilters/interface/HLTCutExpression.h"
+#include "HLTrigger/HLTfilters/interface/HLTCutAccessors.h"
+#include "HLTrigger/HLTfilters/interface/HLTCutColumns.h"
+
+//
+// class declaration
+//
+
+template<typename T>
+class HLTCutSelector {
+
+   public:
+      typedef typename HLTCutAccessors<T>::Accessor Accessor;
+
+      /// shared selector for the given cut, created on first use;
+      /// as for the rest of module construction, this is not meant to be called concurrently
+      static boost::shared_ptr<const HLTCutSelector> get(const std::string & cut) {
+        static std::map<std::string, boost::shared_ptr<const HLTCutSelector> > cache;
+        const std::string key(HLTCutExpression::normalize(cut));
+        boost::shared_ptr<const HLTCutSelector> & selector = cache[key];
+        if (not selector)
+          selector.reset(new HLTCutSelector(cut));
+        return selector;
+      }
+
+      explicit HLTCutSelector(const std::string & cut) :
+        expression_(cut),
+        accessors_(),
+        fallback_()
+      {
+        bool compiled = expression_.valid();
+        for (unsigned int i=0; compiled and i!=expression_.variables().size(); ++i) {
+          const Accessor accessor = HLTCutAccessors<T>::find(expression_.variables()[i]);
+          compiled = (accessor != 0);
+          accessors_.push_back(accessor);
+        }
+        if (not compiled) {
+          accessors_.clear();
+          fallback_.reset(new StringCutObjectSelector<T,true>(cut));
+        }
+      }
+
+      /// true if the cut is evaluated by the compiled expression
+      bool compiled() const {
+        return fallback_.get() == 0;
+      }
+
+      /// evaluate the cut on a single object
+      bool operator()(const T & object) const {
+        if (fallback_.get())
+          return (*fallback_)(object);
+
+        double values[HLTCutExpression::kMaxVariables];
+        for (unsigned int i=0; i!=accessors_.size(); ++i)
+          values[i] = (*accessors_[i])(object);
+        return expression_(values);
+      }
+
+      /// evaluate the cut on all the objects, setting pass[i] for the objects passing it
+      void select(const std::vector<T> & objects, HLTCutExpression::Workspace & workspace, std::vector<unsigned char> & pass) const {
+        const unsigned int size(objects.size());
+        if (fallback_.get()) {
+          pass.resize(size);
+          for (unsigned int i=0; i!=size; ++i)
+            pass[i] = (*fallback_)(objects[i]);
+          return;
+        }
+
+        // gather the variables used by the cut
+        const double * columns[HLTCutExpression::kMaxVariables];
+        workspace.variables.resize(accessors_.size());
+        for (unsigned int v=0; v!=accessors_.size(); ++v) {
+          const Accessor accessor = accessors_[v];
+          std::vector<double> & column = workspace.variables[v];
+          column.resize(size);
+          for (unsigned int i=0; i!=size; ++i)
+            column[i] = (*accessor)(objects[i]);
+          columns[v] = size ? & column.front() : 0;
+        }
+        expression_(columns, size, workspace, pass);
+      }
+
+      /// evaluate the cut on the objects in [first, last) of the view, setting pass[i-first] for the objects passing it
+      void select(const HLTCutColumns<T> & view, unsigned int first, unsigned int last, HLTCutExpression::Workspace & workspace, std::vector<unsigned char> & pass) const {
+        const unsigned int size(last-first);
+        if (fallback_.get()) {
+          pass.resize(size);
+          for (unsigned int i=0; i!=size; ++i)
+            pass[i] = (*fallback_)(view.objects()[first+i]);
+          return;
+        }
+
+        // the columns of the view are used in place
+        const double * columns[HLTCutExpression::kMaxVariables];
+        for (unsigned int v=0; v!=accessors_.size(); ++v)
+          columns[v] = size ? view.column(accessors_[v]) + first : 0;
+        expression_(columns, size, workspace, pass);
+      }
+
+      /// evaluate the cut on the objects of the view at the given indices, setting pass[k] for the object at indices[k] if it passes it
+      template<typename I>
+      void select(const HLTCutColumns<T> & view, const std::vector<I> & indices, HLTCutExpression::Workspace & workspace, std::vector<unsigned char> & pass) const {
+        const unsigned int size(indices.size());
+        if (fallback_.get()) {
+          pass.resize(size);
+          for (unsigned int k=0; k!=size; ++k)
+            pass[k] = (*fallback_)(view.objects()[indices[k]]);
+          return;
+        }
+
+        // gather the variables used by the cut from the columns of the view
+        const double * columns[HLTCutExpression::kMaxVariables];
+        workspace.variables.resize(accessors_.size());
+        for (unsigned int v=0; v!=accessors_.size(); ++v) {
+          const double * values = size ? view.column(accessors_[v]) : 0;
+          std::vector<double> & column = workspace.variables[v];
+          column.resize(size);
+          for (unsigned int k=0; k!=size; ++k)
+            column[k] = values[indices[k]];
+          columns[v] = size ? & column.front() : 0;
+        }
+        expression_(columns, size, workspace, pass);
+      }
+
+   private:
+      // not copyable, as it owns the fallback selector
+      HLTCutSelector(const HLTCutSelector &);
+      HLTCutSelector & operator=(const HLTCutSelector &);
+
+      HLTCutExpression expression_;                               // compiled cut
+      std::vector<Accessor> accessors_;                           // accessors of the variables used by the compiled cut
+      std::auto_ptr<StringCutObjectSelector<T,true> > fallback_;  // selector used if the cut could not be compiled
+};
+
+#endif // HLTCutSelector_h
@@ -12,6 +12,25 @@
  *  single-object-type filters so that the access is thorugh
  *  RefToBases and polymorphic.
  *
+ *  If a Deta or DelR window is active, the second objects are indexed by
+ *  eta, and only those within the window around the first object are
+ *  considered; the pairs are still evaluated, and recorded, in the same
+ *  order as in the full loop over all pairs.
+ *
+ *  The active cuts are checked in a fixed order, from the cheapest ones,
+ *  and each variable is computed only when needed, so that each pair
+ *  costs only what its configuration requires; the DelR window is
+ *  checked on DelR^2, avoiding the sqrt. The Refs are resolved once per
+ *  event into contiguous arrays, see HLTObjectColumns, and the cuts are
+ *  checked on blocks of pairs at a time, in loops without branches.
+ *
+ *  With uniqueObjects, each object is recorded once in the filter object,
+ *  rather than once per passing pair, while MinN still counts the pairs;
+ *  with savePairs, the indices of the 1st and 2nd objects of each passing
+ *  pair, within the objects of the input filters, are put in the event
+ *  as a flat vector<unsigned int> (i1, i2, i1, i2, ...). With decisionOnly,
+ *  no pairs are recorded, and the search stops after MinN passing pairs.
+ *
  *  $Date: 2012/02/23 11:48:34 $
  *  $Revision: 1.8 $
  *
@@ -21,9 +40,12 @@
 
 #include "DataFormats/Common/interface/Ref.h"
 #include "HLTrigger/HLTcore/interface/HLTFilter.h"
+#include "HLTrigger/HLTfilters/interface/HLTObjectColumns.h"
+#include "HLTrigger/HLTfilters/interface/HLTCollectionTags.h"
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 #include<string>
 #include<vector>
+#include<utility>
 
 //
 // class declaration
@@ -40,6 +62,15 @@ class HLTDoublet : public HLTFilter {
       virtual bool hltFilter(edm::Event&, const edm::EventSetup&, trigger::TriggerFilterObjectWithRefs & filterproduct);
 
    private:
+      // number of pairs whose cuts are checked at once
+      static const unsigned int kBlock = 64;
+
+      // check the cuts on the pairs of the 1st object i1 with the 2nd objects i2[0..size), setting pass[j] for the passing ones
+      void selectPairs(unsigned int i1, const unsigned int * i2, unsigned int size, unsigned char * pass) const;
+
+      // record the objects of the passing pair (i1, i2), and their indices
+      void addPair(unsigned int i1, unsigned int i2, trigger::TriggerFilterObjectWithRefs & filterproduct, std::vector<unsigned int> & pairs);
+
       // configuration
       edm::InputTag originTag1_;  // input tag identifying original 1st product
       edm::InputTag originTag2_;  // input tag identifying original 2nd product
@@ -53,10 +84,21 @@ class HLTDoublet : public HLTFilter {
       double min_DelR_,max_DelR_; // Delta R window
       double min_Pt_  ,max_Pt_;   // Pt(1,2) window
       int    min_N_;              // number of pairs passing cuts required
+      bool   uniqueObjects_;      // record each object once, rather than once per passing pair
+      bool   savePairs_;          // put the indices of the objects of the passing pairs in the event
+      bool   decisionOnly_;       // only take the decision, stopping after min_N_ pairs, without recording them
 
       // calculated from configuration in c'tor
       bool   same_;                      // 1st and 2nd product are one and the same
       bool   cutdphi_,cutdeta_,cutminv_,cutdelr_,cutpt_; // cuts are on=true or off=false
+      bool   window_;                    // a Deta or DelR window limits the |Deta| of the pairs
+      double max_eta_;                   // ... to this value
+      double min_DelR2_,max_DelR2_;      // Delta R window, squared
+
+      // the active cuts, in the order they are checked
+      enum Cut { kDeta, kDphi, kDelR, kPt, kMinv };
+      std::vector<Cut> cuts_;
+      unsigned int groups_;              // groups of variables needed by the cuts
 
       std::string label_;         // module label
 
@@ -68,6 +110,21 @@ class HLTDoublet : public HLTFilter {
       typedef edm::Ref<T2Collection> T2Ref;
       std::vector<T2Ref> coll2_;
 
+      // variables of the 1st and 2nd objects, stored contiguously
+      HLTObjectColumns columns1_;
+      HLTObjectColumns columns2_;
+
+      // InputTags of the products the Refs point to, cached, and those of the current collection
+      HLTCollectionTags collectionTags_;
+      std::vector<edm::InputTag> tags_;
+
+      // objects already recorded, with uniqueObjects
+      std::vector<bool> saved1_;
+      std::vector<bool> saved2_;
+
+      // eta and index of the 2nd objects, sorted by eta, and indices of the 2nd objects within the eta window
+      std::vector<std::pair<double,unsigned int> > eta2_;
+      std::vector<unsigned int> window2_;
 };
 
 #endif //HLTDoublet_h
@@ -4,13 +4,32 @@
 // 
 // Class imlements |dZ|<Max for a pair of two objects
 //
+// The 2nd objects are sorted by vz, and only those within the DZ window
+// around each 1st object are considered; the pairs are still evaluated,
+// and recorded, in the same order as in the full loop over all pairs.
+// The Refs are resolved once per event into contiguous arrays, see
+// HLTObjectColumns, and the DeltaR and dZ cuts are checked on blocks
+// of pairs at a time, in loops without branches; the DeltaR cut is
+// checked on DeltaR^2, and the supercluster check only for the pairs
+// passing the other cuts.
+//
+// With uniqueObjects, each object is recorded once in the filter object,
+// rather than once per passing pair, while MinN still counts the pairs;
+// with savePairs, the indices of the 1st and 2nd objects of each passing
+// pair, within the objects of the input filters, are put in the event as
+// a flat vector<unsigned int> (i1, i2, i1, i2, ...). With decisionOnly,
+// no pairs are recorded, and the search stops after MinN passing pairs.
+//
 
 #include "DataFormats/Common/interface/Ref.h"
 #include "DataFormats/HLTReco/interface/TriggerTypeDefs.h"
 #include "HLTrigger/HLTcore/interface/HLTFilter.h"
+#include "HLTrigger/HLTfilters/interface/HLTObjectColumns.h"
+#include "HLTrigger/HLTfilters/interface/HLTCollectionTags.h"
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 #include<string>
 #include<vector>
+#include<utility>
 
 //
 // class declaration
@@ -27,6 +46,15 @@ class HLTDoubletDZ : public HLTFilter {
       virtual bool hltFilter(edm::Event&, const edm::EventSetup&, trigger::TriggerFilterObjectWithRefs & filterproduct);
 
    private:
+      // number of pairs whose cuts are checked at once
+      static const unsigned int kBlock = 64;
+
+      // check the cuts on the pairs of the 1st object i1 with the 2nd objects i2[0..size), setting pass[j] for the passing ones
+      void selectPairs(unsigned int i1, const unsigned int * i2, unsigned int size, unsigned char * pass) const;
+
+      // record the objects of the passing pair (i1, i2), and their indices
+      void addPair(unsigned int i1, unsigned int i2, trigger::TriggerFilterObjectWithRefs & filterproduct, std::vector<unsigned int> & pairs);
+
       // configuration
       edm::InputTag originTag1_;  // input tag identifying original 1st product
       edm::InputTag originTag2_;  // input tag identifying original 2nd product
@@ -38,7 +66,12 @@ class HLTDoubletDZ : public HLTFilter {
       double maxDZ_;              // number of pairs passing cuts required
       bool   same_;               // 1st and 2nd product are one and the same
       int    min_N_;              // number of pairs passing cuts required
+      bool   uniqueObjects_;      // record each object once, rather than once per passing pair
+      bool   savePairs_;          // put the indices of the objects of the passing pairs in the event
+      bool   decisionOnly_;       // only take the decision, stopping after min_N_ pairs, without recording them
       bool   checkSC_;            // make sure SC constituents are different
+      double minDR2_;             // minDR_ squared
+      unsigned int groups_;       // groups of variables needed by the cuts
 
       std:: string label_;        // module label
 
@@ -49,6 +82,22 @@ class HLTDoubletDZ : public HLTFilter {
       typedef edm::Ref<T2Collection> T2Ref;
       std::vector<T2Ref> coll2_;
 
+      // variables of the 1st and 2nd objects, stored contiguously
+      HLTObjectColumns columns1_;
+      HLTObjectColumns columns2_;
+
+      // InputTags of the products the Refs point to, cached, and those of the current collection
+      HLTCollectionTags collectionTags_;
+      std::vector<edm::InputTag> tags_;
+
+      // objects already recorded, with uniqueObjects
+      std::vector<bool> saved1_;
+      std::vector<bool> saved2_;
+
+      // vz and index of the 2nd objects, sorted by vz, those with an undefined vz, and indices of the 2nd objects within the DZ window
+      std::vector<std::pair<double,unsigned int> > vz2_;
+      std::vector<unsigned int> undefined2_;
+      std::vector<unsigned int> window2_;
 
 };
 
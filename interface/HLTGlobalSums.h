@@ -40,6 +40,7 @@ class HLTGlobalSums : public HLTFilter {
       std::string observable_; // which observable to cut on
       double min_,max_;        // cut: Min<=observable<=Max
       int min_N_;              // how many needed to pass
+      bool decisionOnly_;      // only take the decision, stopping after min_N_ objects, without recording them
       int tid_;                // actual triggerType
 };
 
@@ -0,0 +1,144 @@
+#ifndef HLTKinematicCuts_h
+#define HLTKinematicCuts_h
+
+/** \class HLTKinematicCuts
+ *
+ *
+ *  Cuts on the energy, pt, mass and |eta| of single objects, as used by
+ *  the HLTSinglet and HLTMultiSinglet filters.
+ *
+ *  The active cuts are resolved once, at construction, into a kernel
+ *  specialised at compile time, so that disabled cuts cost nothing:
+ *  only the variables needed by the active cuts are gathered into
+ *  contiguous arrays, and the cuts are evaluated without branches.
+ *  The mass cut is evaluated on the squared mass, and the |eta| cut on
+ *  |pz| against pt*sinh(MaxEta), to avoid the sqrt and log.
+ *
+ *  A negative MinE, MinPt, MinMass or MaxEta disables the cut; a MinE or
+ *  MinPt of 0 is also treated as disabled, as it cannot reject anything.
+ *
+ *  \author Martin Grunewald
+ *
+ */
+
+#include <vector>
+#include <cmath>
+
+//
+// class declaration
+//
+
+class HLTKinematicCuts {
+
+   public:
+      enum Cut {
+        kEnergy = 0x01,
+        kPt     = 0x02,
+        kMass   = 0x04,
+        kEta    = 0x08
+      };
+
+      // kinematic variables of a range of objects, stored contiguously
+      struct Columns {
+        std::vector<double> energy;
+        std::vector<double> pt;
+        std::vector<double> mass2;    // squared mass
+        std::vector<double> pz;       // |pz|
+      };
+
+      HLTKinematicCuts(double min_E, double min_Pt, double min_Mass, double max_Eta) :
+        min_E_(min_E),
+        min_Pt_(min_Pt),
+        min_Mass2_(min_Mass * min_Mass),
+        sinh_Eta_(std::sinh(max_Eta)),
+        active_(0),
+        kernel_(0)
+      {
+        if (min_E    >  0.0) active_ |= kEnergy;
+        if (min_Pt   >  0.0) active_ |= kPt;
+        if (min_Mass >= 0.0) active_ |= kMass;
+        if (max_Eta  >= 0.0) active_ |= kEta;
+        kernel_ = Dispatch<kEnergy | kPt | kMass | kEta>::kernel(active_);
+      }
+
+      /// active cuts
+      unsigned int active() const {
+        return active_;
+      }
+
+      /// evaluate the cuts on a single object
+      template<typename T>
+      bool operator()(const T & object) const {
+        return ( (not (active_ & kEnergy)) or (object.energy()  >= min_E_    ) ) and
+               ( (not (active_ & kPt    )) or (object.pt()      >= min_Pt_   ) ) and
+               ( (not (active_ & kMass  )) or (object.massSqr() >= min_Mass2_) ) and
+               ( (not (active_ & kEta   )) or (std::abs(object.pz()) <= object.pt() * sinh_Eta_) );
+      }
+
+      /// gather into the columns the variables needed by the given cuts, for the first size objects
+      template<typename T>
+      static void gather(const std::vector<T> & objects, unsigned int size, unsigned int active, Columns & columns) {
+        if (active & kEnergy) {
+          columns.energy.resize(size);
+          for (unsigned int i=0; i!=size; ++i) columns.energy[i] = objects[i].energy();
+        }
+        if (active & (kPt | kEta)) {
+          columns.pt.resize(size);
+          for (unsigned int i=0; i!=size; ++i) columns.pt[i] = objects[i].pt();
+        }
+        if (active & kMass) {
+          columns.mass2.resize(size);
+          for (unsigned int i=0; i!=size; ++i) columns.mass2[i] = objects[i].massSqr();
+        }
+        if (active & kEta) {
+          columns.pz.resize(size);
+          for (unsigned int i=0; i!=size; ++i) columns.pz[i] = std::abs(objects[i].pz());
+        }
+      }
+
+      /// evaluate the cuts on the first size objects of the columns, which must have been gathered for (at least) the active cuts
+      void select(const Columns & columns, unsigned int size, std::vector<unsigned char> & pass) const {
+        pass.resize(size);
+        (*kernel_)(*this, columns, size, pass);
+      }
+
+   private:
+      typedef void (*Kernel)(const HLTKinematicCuts &, const Columns &, unsigned int, std::vector<unsigned char> &);
+
+      // the cuts in CUTS are evaluated without branches, so that the loop can be vectorised
+      template<unsigned int CUTS>
+      static void evaluate(const HLTKinematicCuts & cuts, const Columns & columns, unsigned int size, std::vector<unsigned char> & pass) {
+        for (unsigned int i=0; i!=size; ++i) {
+          bool result(true);
+          if (CUTS & kEnergy) result &= (columns.energy[i] >= cuts.min_E_);
+          if (CUTS & kPt)     result &= (columns.pt[i]     >= cuts.min_Pt_);
+          if (CUTS & kMass)   result &= (columns.mass2[i]  >= cuts.min_Mass2_);
+          if (CUTS & kEta)    result &= (columns.pz[i]     <= columns.pt[i] * cuts.sinh_Eta_);
+          pass[i] = result;
+        }
+      }
+
+      // select the kernel specialised for the given active cuts
+      template<unsigned int CUTS, int dummy = 0>
+      struct Dispatch {
+        static Kernel kernel(unsigned int active) {
+          return (active == CUTS) ? & evaluate<CUTS> : Dispatch<CUTS - 1>::kernel(active);
+        }
+      };
+
+      template<int dummy>
+      struct Dispatch<0, dummy> {
+        static Kernel kernel(unsigned int active) {
+          return & evaluate<0>;
+        }
+      };
+
+      double min_E_;            // energy threshold in GeV
+      double min_Pt_;           // pt threshold in GeV
+      double min_Mass2_;        // squared mass threshold in GeV^2
+      double sinh_Eta_;         // sinh of the eta range (symmetric)
+      unsigned int active_;     // active cuts
+      Kernel kernel_;           // kernel specialised for the active cuts
+};
+
+#endif // HLTKinematicCuts_h
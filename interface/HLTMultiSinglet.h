@@ -0,0 +1,71 @@
+#ifndef HLTMultiSinglet_h
+#define HLTMultiSinglet_h
+
+/** \class HLTMultiSinglet
+ *
+ *
+ *  This class is an HLTFilter (-> EDFilter) implementing several basic
+ *  HLT triggers for single objects of the same physics type, as the
+ *  HLTSinglet does, each with its own set of cuts on variables relating
+ *  to their 4-momentum representation (e.g. a ladder of thresholds).
+ *  The collection is read and scanned only once for all the sets of cuts.
+ *
+ *  For each set of cuts a separate filter object is put in the Event,
+ *  with the name of the set as product instance name, and the decisions
+ *  are stored as a std::vector<bool>, with the names stored in the Run,
+ *  so that each of them can be used by a TriggerBitFilter.
+ *  The usual filter object holds all objects passing any set of cuts,
+ *  and the filter accepts the event if any set of cuts is satisfied.
+ *
+ *  Only reco types are supported, as the actual trigger type of L1
+ *  objects is not looked up object-by-object.
+ *
+ *  \author Martin Grunewald
+ *
+ */
+
+#include<vector>
+#include<string>
+#include "DataFormats/HLTReco/interface/TriggerTypeDefs.h"
+#include "HLTrigger/HLTcore/interface/HLTFilter.h"
+#include "HLTrigger/HLTfilters/interface/HLTKinematicCuts.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+
+//
+// class declaration
+//
+
+template<typename T>
+class HLTMultiSinglet : public HLTFilter {
+
+   public:
+      explicit HLTMultiSinglet(const edm::ParameterSet&);
+      ~HLTMultiSinglet();
+      static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
+      virtual bool beginRun(edm::Run&, const edm::EventSetup&);
+      virtual bool hltFilter(edm::Event&, const edm::EventSetup&, trigger::TriggerFilterObjectWithRefs & filterproduct);
+
+   private:
+      // a set of cuts, with the same meaning as in HLTSinglet
+      struct Cuts {
+        Cuts(const std::string & name, const HLTKinematicCuts & cuts, int min_N) :
+          name(name), cuts(cuts), min_N(min_N)
+        { }
+
+        std::string      name;  // name of the set of cuts
+        HLTKinematicCuts cuts;  // cuts, specialised for the active ones
+        int              min_N; // number of objects passing cuts required
+      };
+
+      edm::InputTag inputTag_;  // input tag identifying product
+      int    triggerType_ ;     // triggerType configured
+      std::vector<Cuts> cuts_;  // sets of cuts
+      unsigned int active_;     // cuts active in any set
+
+      // kinematic variables of all objects, stored contiguously for the cut evaluation
+      HLTKinematicCuts::Columns columns_;
+      std::vector<unsigned char> pass_; // objects passing the current set of cuts
+      std::vector<unsigned char> any_;  // objects passing any set of cuts
+};
+
+#endif // HLTMultiSinglet_h
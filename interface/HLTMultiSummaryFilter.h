@@ -0,0 +1,65 @@
+#ifndef HLTMultiSummaryFilter_h
+#define HLTMultiSummaryFilter_h
+
+/** \class HLTMultiSummaryFilter
+ *
+ *
+ *  This class is an HLTFilter (-> EDFilter) implementing several smart
+ *  HLT trigger cuts on objects in the TriggerSummaryAOD product, as the
+ *  HLTSummaryFilter does, each for its own filter or collection, cut and
+ *  minimum number of objects. The summary is read only once, and the
+ *  columnar view of its trigger objects is shared by all the selections.
+ *
+ *  The decisions are stored as a std::vector<bool>, with the names of the
+ *  selections stored in the Run, so that each of them can be used by a
+ *  TriggerBitFilter; the filter accepts the event if any selection is
+ *  satisfied.
+ *
+ *  \author Martin Grunewald
+ *
+ */
+
+#include<vector>
+#include<string>
+#include<boost/shared_ptr.hpp>
+
+#include "HLTrigger/HLTcore/interface/HLTFilter.h"
+#include "DataFormats/HLTReco/interface/TriggerEvent.h"
+#include "HLTrigger/HLTfilters/interface/HLTCutSelector.h"
+#include "HLTrigger/HLTfilters/interface/HLTSummaryMember.h"
+
+//
+// class declaration
+//
+
+class HLTMultiSummaryFilter : public HLTFilter {
+
+   public:
+      explicit HLTMultiSummaryFilter(const edm::ParameterSet&);
+      ~HLTMultiSummaryFilter();
+      virtual bool beginRun(edm::Run&, const edm::EventSetup&);
+      virtual bool hltFilter(edm::Event&, const edm::EventSetup&, trigger::TriggerFilterObjectWithRefs & filterproduct);
+
+   private:
+      // a selection, with the same meaning as in HLTSummaryFilter
+      struct Selection {
+        Selection(const std::string & name, const edm::InputTag & member, const std::string & cut, int min_N) :
+          name(name), member(member), select(HLTCutSelector<trigger::TriggerObject>::get(cut)), min_N(min_N)
+        { }
+
+        std::string      name;    // name of the selection
+        HLTSummaryMember member;  // which packed-up collection or filter
+        boost::shared_ptr<const HLTCutSelector<trigger::TriggerObject> > select; // smart selector
+        int              min_N;   // number of objects passing cuts required
+      };
+
+      edm::InputTag summaryTag_;            // input tag identifying TriggerSummaryAOD
+      std::vector<Selection> selections_;   // selections
+
+      // buffers for the evaluation of the cuts
+      HLTCutColumns<trigger::TriggerObject> columns_;  // columnar view of the trigger objects of the current event
+      HLTCutExpression::Workspace workspace_;
+      std::vector<unsigned char> pass_;     // objects passing the current cut
+};
+
+#endif //HLTMultiSummaryFilter_h
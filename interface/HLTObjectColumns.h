@@ -0,0 +1,75 @@
+#ifndef HLTObjectColumns_h
+#define HLTObjectColumns_h
+
+/** \class HLTObjectColumns
+ *
+ *
+ *  Kinematic variables of a list of objects, as used by the HLTDoublet
+ *  and HLTDoubletDZ filters: the Refs are resolved once per event, and
+ *  only the groups of variables the filter needs are stored, contiguously,
+ *  so that the pair loops run on plain arrays.
+ *
+ *  \author Martin Grunewald
+ *
+ */
+
+#include <vector>
+
+//
+// class declaration
+//
+
+class HLTObjectColumns {
+
+   public:
+      enum Group {
+        kMomentum  = 0x01,    // px, py, pz, energy
+        kDirection = 0x02,    // eta, phi
+        kVertex    = 0x04     // vz
+      };
+
+      HLTObjectColumns() :
+        px(), py(), pz(), energy(), eta(), phi(), vz()
+      { }
+
+      /// fill the given groups of variables for all the objects
+      template<typename R>
+      void fill(const std::vector<R> & refs, unsigned int groups) {
+        const unsigned int size(refs.size());
+        if (groups & kMomentum) {
+          px.resize(size);
+          py.resize(size);
+          pz.resize(size);
+          energy.resize(size);
+          for (unsigned int i=0; i!=size; ++i) {
+            px[i]     = refs[i]->px();
+            py[i]     = refs[i]->py();
+            pz[i]     = refs[i]->pz();
+            energy[i] = refs[i]->energy();
+          }
+        }
+        if (groups & kDirection) {
+          eta.resize(size);
+          phi.resize(size);
+          for (unsigned int i=0; i!=size; ++i) {
+            eta[i]    = refs[i]->eta();
+            phi[i]    = refs[i]->phi();
+          }
+        }
+        if (groups & kVertex) {
+          vz.resize(size);
+          for (unsigned int i=0; i!=size; ++i)
+            vz[i]     = refs[i]->vz();
+        }
+      }
+
+      std::vector<double> px;
+      std::vector<double> py;
+      std::vector<double> pz;
+      std::vector<double> energy;
+      std::vector<double> eta;
+      std::vector<double> phi;
+      std::vector<double> vz;
+};
+
+#endif // HLTObjectColumns_h
@@ -0,0 +1,119 @@
+#ifndef HLTPairCuts_h
+#define HLTPairCuts_h
+
+/** \class HLTPairCuts
+ *
+ *
+ *  Cuts on a pair of objects, as used by the HLTTriplet filter: windows
+ *  on Deta, Dphi, DelR, and on the invariant mass and pt of the pair,
+ *  with the same parameters and meaning as in HLTDoublet; a window with
+ *  Min > Max is disabled.
+ *
+ *  The variables of the objects are taken from HLTObjectColumns, filled
+ *  with the groups returned by groups(); the DelR window is checked on
+ *  DelR^2, avoiding the sqrt.
+ *
+ *  \author Martin Grunewald
+ *
+ */
+
+#include <cmath>
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "HLTrigger/HLTfilters/interface/HLTObjectColumns.h"
+
+//
+// class declaration
+//
+
+class HLTPairCuts {
+
+   public:
+      explicit HLTPairCuts(const edm::ParameterSet & config) :
+        min_Dphi_ (config.getParameter<double>("MinDphi")),
+        max_Dphi_ (config.getParameter<double>("MaxDphi")),
+        min_Deta_ (config.getParameter<double>("MinDeta")),
+        max_Deta_ (config.getParameter<double>("MaxDeta")),
+        min_Minv_ (config.getParameter<double>("MinMinv")),
+        max_Minv_ (config.getParameter<double>("MaxMinv")),
+        min_DelR_ (config.getParameter<double>("MinDelR")),
+        max_DelR_ (config.getParameter<double>("MaxDelR")),
+        min_Pt_   (config.getParameter<double>("MinPt")),
+        max_Pt_   (config.getParameter<double>("MaxPt")),
+        cutdphi_ (min_Dphi_ <= max_Dphi_),
+        cutdeta_ (min_Deta_ <= max_Deta_),
+        cutminv_ (min_Minv_ <= max_Minv_),
+        cutdelr_ (min_DelR_ <= max_DelR_),
+        cutpt_   (min_Pt_   <= max_Pt_  ),
+        // as DelR is not negative, a negative bound is replaced by -1
+        min_DelR2_ ((min_DelR_ > 0.) ? min_DelR_*min_DelR_ : -1.),
+        max_DelR2_ ((max_DelR_ < 0.) ? -1. : max_DelR_*max_DelR_)
+      { }
+
+      /// add the parameters of the cuts, all disabled by default
+      static void fillDescription(edm::ParameterSetDescription & desc) {
+        desc.add<double>("MinDphi",+1.0);
+        desc.add<double>("MaxDphi",-1.0);
+        desc.add<double>("MinDeta",+1.0);
+        desc.add<double>("MaxDeta",-1.0);
+        desc.add<double>("MinMinv",+1.0);
+        desc.add<double>("MaxMinv",-1.0);
+        desc.add<double>("MinDelR",+1.0);
+        desc.add<double>("MaxDelR",-1.0);
+        desc.add<double>("MinPt"  ,+1.0);
+        desc.add<double>("MaxPt"  ,-1.0);
+      }
+
+      /// true if any cut is active
+      bool active() const {
+        return cutdphi_ || cutdeta_ || cutminv_ || cutdelr_ || cutpt_;
+      }
+
+      /// groups of HLTObjectColumns variables needed by the active cuts
+      unsigned int groups() const {
+        unsigned int groups(0);
+        if (cutdeta_ || cutdphi_ || cutdelr_) groups |= HLTObjectColumns::kDirection;
+        if (cutpt_ || cutminv_)               groups |= HLTObjectColumns::kMomentum;
+        return groups;
+      }
+
+      /// evaluate the cuts on the pair of the objects i1 and i2 of the given columns
+      bool operator()(const HLTObjectColumns & c1, unsigned int i1, const HLTObjectColumns & c2, unsigned int i2) const {
+        if (cutdeta_ || cutdphi_ || cutdelr_) {
+          const double Deta(std::abs(c1.eta[i1]-c2.eta[i2]));
+          if (cutdeta_ && !((min_Deta_<=Deta) && (Deta<=max_Deta_))) return false;
+          const double dphi(std::abs(c1.phi[i1]-c2.phi[i2]));
+          const double Dphi((dphi>M_PI) ? 2.0*M_PI-dphi : dphi);
+          if (cutdphi_ && !((min_Dphi_<=Dphi) && (Dphi<=max_Dphi_))) return false;
+          const double DelR2(Dphi*Dphi+Deta*Deta);
+          if (cutdelr_ && !((min_DelR2_<=DelR2) && (DelR2<=max_DelR2_))) return false;
+        }
+        if (cutpt_ || cutminv_) {
+          const double px(c1.px[i1]+c2.px[i2]);
+          const double py(c1.py[i1]+c2.py[i2]);
+          if (cutpt_) {
+            const double Pt(std::sqrt(px*px+py*py));
+            if (!((min_Pt_<=Pt) && (Pt<=max_Pt_))) return false;
+          }
+          if (cutminv_) {
+            const double pz(c1.pz[i1]+c2.pz[i2]);
+            const double E (c1.energy[i1]+c2.energy[i2]);
+            const double Minv(std::sqrt(std::abs(E*E-px*px-py*py-pz*pz)));
+            if (!((min_Minv_<=Minv) && (Minv<=max_Minv_))) return false;
+          }
+        }
+        return true;
+      }
+
+   private:
+      double min_Dphi_,max_Dphi_;   // Delta phi window
+      double min_Deta_,max_Deta_;   // Delta eta window
+      double min_Minv_,max_Minv_;   // Minv(1,2) window
+      double min_DelR_,max_DelR_;   // Delta R window
+      double min_Pt_  ,max_Pt_;     // Pt(1,2) window
+      bool   cutdphi_,cutdeta_,cutminv_,cutdelr_,cutpt_;   // cuts are on=true or off=false
+      double min_DelR2_,max_DelR2_; // Delta R window, squared
+};
+
+#endif // HLTPairCuts_h
@@ -8,6 +8,14 @@
  *  trigger for single objects of the same physics type, cutting on
  *  variables relating to their 4-momentum representation
  *
+ *  If assumePtSorted is set, the input collection is trusted to be sorted
+ *  by decreasing pt, and only the leading objects above the pt threshold,
+ *  found with a binary search, are considered: objects above the threshold
+ *  further down an unsorted collection are silently lost. Only in builds
+ *  with EDM_ML_DEBUG the whole ordering is checked, and if it does not hold
+ *  a warning is issued, in the category HLTSingletNotPtSorted, and all the
+ *  objects are considered.
+ *
  *  $Date: 2012/02/23 12:21:51 $
  *  $Revision: 1.8 $
  *
@@ -18,6 +26,7 @@
 #include<vector>
 #include "DataFormats/HLTReco/interface/TriggerTypeDefs.h"
 #include "HLTrigger/HLTcore/interface/HLTFilter.h"
+#include "HLTrigger/HLTfilters/interface/HLTKinematicCuts.h"
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 
 //
@@ -34,6 +43,9 @@ class HLTSinglet : public HLTFilter {
       virtual bool hltFilter(edm::Event&, const edm::EventSetup&, trigger::TriggerFilterObjectWithRefs & filterproduct);
 
    private:
+      // number of leading objects with pt above threshold, assuming the collection is sorted by decreasing pt
+      unsigned int ptSortedSize(const std::vector<T> & objects) const;
+
       edm::InputTag inputTag_;  // input tag identifying product
       int    triggerType_ ;     // triggerType configured
       double min_E_;            // energy threshold in GeV 
@@ -41,7 +53,14 @@ class HLTSinglet : public HLTFilter {
       double min_Mass_;         // mass threshold in GeV 
       double max_Eta_;          // eta range (symmetric)
       int    min_N_;            // number of objects passing cuts required
-      int    tid_;              // actual triggerType
+      bool   decisionOnly_;     // only take the decision, stopping after min_N_ objects, without recording them
+      bool   assumePtSorted_;   // the input collection is sorted by decreasing pt
+
+      HLTKinematicCuts cuts_;   // cuts, specialised for the active ones
+
+      // kinematic variables of all objects, stored contiguously for the cut evaluation
+      HLTKinematicCuts::Columns columns_;
+      std::vector<unsigned char> pass_; // objects passing all cuts
 };
 
 #endif // HLTSinglet_h
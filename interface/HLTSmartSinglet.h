@@ -10,6 +10,10 @@
  *  variables relating to both the base class T and the derived actual
  *  class
  *
+ *  Cuts using only the common 4-momentum accessors are compiled into
+ *  direct method calls, see HLTCutSelector; any other cut is evaluated
+ *  by a StringCutObjectSelector; modules with the same cut share it
+ *
  *  $Date: 2012/02/23 12:21:51 $
  *  $Revision: 1.10 $
  *
@@ -21,7 +25,7 @@
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 #include<vector>
 
-#include "CommonTools/Utils/interface/StringCutObjectSelector.h"
+#include "HLTrigger/HLTfilters/interface/HLTCutSelector.h"
 #include<string>
 
 //
@@ -43,8 +47,13 @@ class HLTSmartSinglet : public HLTFilter {
       int triggerType_;        // triggerType
       std::string   cut_;      // smart cut
       int           min_N_;    // number of objects passing cuts required
+      bool          decisionOnly_; // only take the decision, stopping after min_N_ objects, without recording them
+
+      boost::shared_ptr<const HLTCutSelector<T> > select_; // smart selector, shared with other modules using the same cut
 
-      StringCutObjectSelector<T,true> select_; // smart selector
+      // buffers for the evaluation of the cut on the whole collection
+      HLTCutExpression::Workspace workspace_;
+      std::vector<unsigned char> pass_; // objects passing the cut
 };
 
 #endif //HLTSmartSinglet_h
@@ -9,6 +9,12 @@
  *  for objects in the TriggerSummaryAOD product, allowing to cut on
  *  variables relating to their 4-momentum representation
  *
+ *  The position of the member filter or collection in the summary is
+ *  cached, see HLTSummaryMember
+ *
+ *  The cut is evaluated on all the selected objects at once, on a columnar
+ *  view of the trigger objects
+ *
  *  $Date: 2009/09/25 13:04:00 $
  *  $Revision: 1.1 $
  *
@@ -19,7 +25,8 @@
 #include "HLTrigger/HLTcore/interface/HLTFilter.h"
 
 #include "DataFormats/HLTReco/interface/TriggerEvent.h"
-#include "CommonTools/Utils/interface/StringCutObjectSelector.h"
+#include "HLTrigger/HLTfilters/interface/HLTCutSelector.h"
+#include "HLTrigger/HLTfilters/interface/HLTSummaryMember.h"
 
 #include<string>
 
@@ -37,11 +44,16 @@ class HLTSummaryFilter : public HLTFilter {
 
    private:
       edm::InputTag summaryTag_; // input tag identifying TriggerSummaryAOD
-      edm::InputTag memberTag_;  // which packed-up collection or filter
+      HLTSummaryMember member_;  // which packed-up collection or filter
       std::string   cut_;        // smart cut
       int           min_N_;      // number of objects passing cuts required
 
-      StringCutObjectSelector<trigger::TriggerObject> select_; // smart selector
+      boost::shared_ptr<const HLTCutSelector<trigger::TriggerObject> > select_; // smart selector, shared with other modules using the same cut
+
+      // buffers for the evaluation of the cut on all the selected objects
+      HLTCutColumns<trigger::TriggerObject> columns_;  // columnar view of the trigger objects of the current event
+      HLTCutExpression::Workspace workspace_;
+      std::vector<unsigned char> pass_;  // objects passing the cut
 };
 
 #endif //HLTSummaryFilter_h
@@ -0,0 +1,63 @@
+#ifndef HLTSummaryMember_h
+#define HLTSummaryMember_h
+
+/** \class HLTSummaryMember
+ *
+ *
+ *  A filter or a collection packed in the TriggerSummaryAOD product, as
+ *  used by the HLTSummaryFilter and HLTMultiSummaryFilter.
+ *
+ *  As in the original HLTSummaryFilter, the member is looked for first
+ *  among the filters, then among the collections. Its position in the
+ *  summary is cached, and only verified in the following events; the
+ *  full lookup is repeated only when the layout of the summary changes.
+ *  A member found as a collection is still looked for among the filters
+ *  in every event, so that a filter with the same tag takes precedence.
+ *
+ *  \author Martin Grunewald
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "DataFormats/HLTReco/interface/TriggerEvent.h"
+#include "HLTrigger/HLTfilters/interface/HLTCutSelector.h"
+
+//
+// class declaration
+//
+
+class HLTSummaryMember {
+
+   public:
+      explicit HLTSummaryMember(const edm::InputTag & tag);
+
+      /// which packed-up collection or filter
+      const edm::InputTag & tag() const {
+        return tag_;
+      }
+
+      /// find the member in the summary, returning false if it is not there
+      bool find(const trigger::TriggerEvent & summary);
+
+      /// after a successful find, true if the member is a filter, false if it is a collection
+      bool filter() const {
+        return filter_;
+      }
+
+      /// evaluate the selector on the objects of the member found in the summary, in the order they are stored
+      void select(const trigger::TriggerEvent & summary, const HLTCutColumns<trigger::TriggerObject> & objects,
+                  const HLTCutSelector<trigger::TriggerObject> & selector,
+                  HLTCutExpression::Workspace & workspace, std::vector<unsigned char> & pass) const;
+
+   private:
+      edm::InputTag      tag_;      // which packed-up collection or filter
+      std::string        encoded_;  // tag_, encoded as in the summary
+      bool               found_;    // tag_ was found in a previous event
+      bool               filter_;   // ... as a filter (true) or a collection (false)
+      trigger::size_type index_;    // ... at this index
+};
+
+#endif // HLTSummaryMember_h
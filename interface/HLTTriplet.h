@@ -0,0 +1,111 @@
+#ifndef HLTTriplet_h
+#define HLTTriplet_h
+
+/** \class HLTTriplet
+ *
+ *
+ *  This class is an HLTFilter (-> EDFilter) implementing a basic HLT
+ *  trigger for triplets of objects, evaluating all triplets with the
+ *  first object from collection 1, the second from collection 2, and
+ *  the third from collection 3, as HLTDoublet does for pairs.
+ *
+ *  Each pair of the triplet can be cut on, with the PSets cuts12,
+ *  cuts13 and cuts23 (see HLTPairCuts), and the whole triplet on its
+ *  invariant mass and pt. The triplets are enumerated pruning on the
+ *  pair cuts first: the (1,2) cuts are checked before looping on the 3rd
+ *  objects, and only then the (1,3) cuts are evaluated, once per 1st
+ *  object, and the (2,3) cuts, once per event for each 2nd object, so
+ *  that the three-body sums are only built for the triplets whose pairs
+ *  all pass.
+ *
+ *  If two of the input collections are the same, each combination of
+ *  their objects is considered only once. With decisionOnly, no
+ *  triplets are recorded, and the search stops after MinN passing
+ *  triplets.
+ *
+ *  \author Martin Grunewald
+ *
+ */
+
+#include "DataFormats/Common/interface/Ref.h"
+#include "HLTrigger/HLTcore/interface/HLTFilter.h"
+#include "HLTrigger/HLTfilters/interface/HLTObjectColumns.h"
+#include "HLTrigger/HLTfilters/interface/HLTPairCuts.h"
+#include "HLTrigger/HLTfilters/interface/HLTCollectionTags.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include<string>
+#include<vector>
+
+//
+// class declaration
+//
+
+template<typename T1, typename T2, typename T3>
+class HLTTriplet : public HLTFilter {
+
+   public:
+
+      explicit HLTTriplet(const edm::ParameterSet&);
+      ~HLTTriplet();
+      static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
+      virtual bool hltFilter(edm::Event&, const edm::EventSetup&, trigger::TriggerFilterObjectWithRefs & filterproduct);
+
+   private:
+      // check the three-body cuts on the triplet (i1, i2, i3)
+      bool selectTriplet(unsigned int i1, unsigned int i2, unsigned int i3) const;
+
+      // add the tags of the original and filtered collection of one input
+      template<typename R>
+      void addCollectionTags(const edm::Event & iEvent, const edm::InputTag & originTag, const std::vector<R> & refs, int index, trigger::TriggerFilterObjectWithRefs & filterproduct);
+
+      // configuration
+      edm::InputTag originTag1_;  // input tag identifying original 1st product
+      edm::InputTag originTag2_;  // input tag identifying original 2nd product
+      edm::InputTag originTag3_;  // input tag identifying original 3rd product
+      edm::InputTag inputTag1_;   // input tag identifying filtered 1st product
+      edm::InputTag inputTag2_;   // input tag identifying filtered 2nd product
+      edm::InputTag inputTag3_;   // input tag identifying filtered 3rd product
+      int triggerType1_;
+      int triggerType2_;
+      int triggerType3_;
+      HLTPairCuts cuts12_;        // cuts on the (1,2) pairs
+      HLTPairCuts cuts13_;        // cuts on the (1,3) pairs
+      HLTPairCuts cuts23_;        // cuts on the (2,3) pairs
+      double min_Minv_,max_Minv_; // Minv(1,2,3) window
+      double min_Pt_  ,max_Pt_;   // Pt(1,2,3) window
+      int    min_N_;              // number of triplets passing cuts required
+      bool   decisionOnly_;       // only take the decision, stopping after min_N_ triplets, without recording them
+
+      // calculated from configuration in c'tor
+      bool   same12_,same13_,same23_;  // the products are one and the same
+      bool   cutminv_,cutpt_;          // cuts are on=true or off=false
+      unsigned int groups_;            // groups of variables needed by the cuts
+
+      //
+      typedef std::vector<T1> T1Collection;
+      typedef edm::Ref<T1Collection> T1Ref;
+      std::vector<T1Ref> coll1_;
+      typedef std::vector<T2> T2Collection;
+      typedef edm::Ref<T2Collection> T2Ref;
+      std::vector<T2Ref> coll2_;
+      typedef std::vector<T3> T3Collection;
+      typedef edm::Ref<T3Collection> T3Ref;
+      std::vector<T3Ref> coll3_;
+
+      // variables of the objects, stored contiguously
+      HLTObjectColumns columns1_;
+      HLTObjectColumns columns2_;
+      HLTObjectColumns columns3_;
+
+      // (1,3) pairs passing the cuts, for the current 1st object, and (2,3) pairs passing the cuts, as a n2 x n3 matrix;
+      // both are only filled once a (1,2) pair passes the cuts, and the rows of the matrix already filled are flagged
+      std::vector<unsigned char> pass13_;
+      std::vector<unsigned char> pass23_;
+      std::vector<unsigned char> done23_;
+
+      // InputTags of the products the Refs point to, cached, and those of the current collection
+      HLTCollectionTags collectionTags_;
+      std::vector<edm::InputTag> tags_;
+};
+
+#endif //HLTTriplet_h
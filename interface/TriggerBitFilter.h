@@ -0,0 +1,62 @@
+#ifndef TriggerBitFilter_h
+#define TriggerBitFilter_h
+
+/** \class TriggerBitFilter
+ *
+ *
+ *  This class is an EDFilter selecting the events where a given bit
+ *  of a std::vector<bool> product is set, e.g. the one produced by the
+ *  TriggerResultsBitsProducer.
+ *
+ *  The bit is looked up by name, in the std::vector<std::string> product
+ *  stored in the Run with the same InputTag as the bits.
+ *
+ *  Authors: Martin Grunewald, Andrea Bocci
+ *
+ */
+
+#include <string>
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EDFilter.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "DataFormats/Provenance/interface/RunID.h"
+
+namespace edm {
+   class ConfigurationDescriptions;
+}
+
+//
+// class declaration
+//
+
+class TriggerBitFilter : public edm::EDFilter {
+public:
+  explicit TriggerBitFilter(const edm::ParameterSet &);
+  ~TriggerBitFilter();
+  static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
+  virtual bool filter(edm::Event &, const edm::EventSetup &);
+
+private:
+  /// look up the index of the requested bit in the names stored in the Run
+  void init(const edm::Run & run);
+
+  /// input bits, and names stored in the Run
+  edm::InputTag m_bits;
+
+  /// name of the requested bit
+  std::string   m_bit;
+
+  /// throw on the requested bit being unknown
+  bool          m_throw;
+
+  /// Run for which m_index has been looked up
+  edm::RunID    m_run;
+
+  /// index of the requested bit, or (unsigned int) -1 if not found
+  unsigned int  m_index;
+};
+
+#endif //TriggerBitFilter_h
@@ -0,0 +1,62 @@
+#ifndef TriggerResultsBitsProducer_h
+#define TriggerResultsBitsProducer_h
+
+/** \class TriggerResultsBitsProducer
+ *
+ *
+ *  This class is an EDProducer evaluating many named logical combinations
+ *  of L1 and HLT results at once, as done by the TriggerResultsFilter.
+ *
+ *  The Event and its trigger results are accessed only once per event for
+ *  all the expressions, and the results are stored in a compact
+ *  std::vector<bool>, with one bit per expression; the expression names
+ *  are stored in the Run, in the same order as the bits, so that a
+ *  TriggerBitFilter can select the events accepted by any one of them.
+ *
+ *  Authors: Martin Grunewald, Andrea Bocci
+ *
+ */
+
+#include <vector>
+#include <string>
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/Run.h"
+#include "FWCore/Framework/interface/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "HLTrigger/HLTcore/interface/TriggerExpressionData.h"
+
+// forward declaration
+namespace triggerExpression {
+  class Evaluator;
+}
+
+//
+// class declaration
+//
+
+class TriggerResultsBitsProducer : public edm::EDProducer {
+public:
+  explicit TriggerResultsBitsProducer(const edm::ParameterSet &);
+  ~TriggerResultsBitsProducer();
+  virtual void beginRun(edm::Run &, const edm::EventSetup &);
+  virtual void produce(edm::Event &, const edm::EventSetup &);
+
+private:
+  /// parse the logical expression into functionals
+  triggerExpression::Evaluator * parse(const std::string & name, const std::string & expression) const;
+  triggerExpression::Evaluator * parse(const std::string & name, const std::vector<std::string> & expressions) const;
+
+  /// names of the trigger conditions, in the same order as the bits
+  std::vector<std::string> m_names;
+
+  /// evaluators for the trigger conditions
+  std::vector<triggerExpression::Evaluator *> m_expressions;
+
+  /// cache some data from the Event for faster access by the m_expressions
+  triggerExpression::Data m_eventCache;
+};
+
+#endif //TriggerResultsBitsProducer_h
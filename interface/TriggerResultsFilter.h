@@ -10,6 +10,15 @@
  *  It has been written as an extension of the HLTHighLevel and HLTHighLevelDev 
  *  filters.
  *
+ *  Note: the "/N" prescale operator is implemented by the Prescaler in
+ *  HLTrigger/HLTcore, which keeps its counter inside the expression tree,
+ *  and accepts one every N events for which its operand is true; as a
+ *  consequence each instance of this filter holds per-job state, its
+ *  results depend on the order in which the events are processed, and it
+ *  must not be shared across concurrent events. Neither per-stream nor
+ *  event-number based prescaling is available here, as both would need
+ *  changes to the Prescaler in HLTrigger/HLTcore.
+ *
  *  $Date: 2012/01/21 14:56:58 $
  *  $Revision: 1.11 $
  *
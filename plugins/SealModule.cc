@@ -61,6 +61,17 @@ typedef HLTSinglet<l1extra::L1EtMissParticle> HLTLevel1MET;    // the actual typ
 typedef HLTSinglet<l1extra::L1JetParticle   > HLTLevel1Jet;    // the actual type is ovrridden object-by-object (TriggerL1CenJet, TriggerL1ForJet or TriggerL1TauJet)
 typedef HLTSinglet<l1extra::L1MuonParticle  > HLTLevel1Muon;   
 
+#include "HLTrigger/HLTfilters/interface/HLTMultiSinglet.h"
+#include "HLTrigger/HLTfilters/src/HLTMultiSinglet.cc"
+
+// filters for HLT candidates, with several sets of cuts
+typedef HLTMultiSinglet<RecoEcalCandidate   > HLT1MultiPhoton   ;
+typedef HLTMultiSinglet<Electron            > HLT1MultiElectron ;
+typedef HLTMultiSinglet<RecoChargedCandidate> HLT1MultiMuon     ;
+typedef HLTMultiSinglet<CaloJet             > HLT1MultiCaloJet  ;
+typedef HLTMultiSinglet<PFTau               > HLT1MultiPFTau    ;
+typedef HLTMultiSinglet<PFJet               > HLT1MultiPFJet    ;
+
 #include "HLTrigger/HLTfilters/interface/HLTSmartSinglet.h"
 #include "HLTrigger/HLTfilters/src/HLTSmartSinglet.cc"
 
@@ -115,6 +126,16 @@ typedef HLTDoubletDZ<Electron            ,Electron>             HLT2ElectronElec
 typedef HLTDoubletDZ<RecoChargedCandidate,RecoChargedCandidate> HLT2MuonMuonDZ;
 typedef HLTDoubletDZ<Electron            ,RecoChargedCandidate> HLT2ElectronMuonDZ;
 
+#include "HLTrigger/HLTfilters/interface/HLTTriplet.h"
+#include "HLTrigger/HLTfilters/src/HLTTriplet.cc"
+typedef HLTTriplet<CaloJet,CaloJet,CaloJet> HLT3CaloJetCaloJetCaloJet;
+typedef HLTTriplet<  PFJet,  PFJet,  PFJet> HLT3PFJetPFJetPFJet;
+
+typedef HLTTriplet<RecoChargedCandidate,RecoChargedCandidate,CaloJet> HLT3MuonMuonCaloJet;
+typedef HLTTriplet<RecoChargedCandidate,RecoChargedCandidate,PFJet  > HLT3MuonMuonPFJet;
+typedef HLTTriplet<Electron            ,Electron            ,CaloJet> HLT3ElectronElectronCaloJet;
+typedef HLTTriplet<Electron            ,Electron            ,PFJet  > HLT3ElectronElectronPFJet;
+
 DEFINE_FWK_MODULE(HLTBool);
 DEFINE_FWK_MODULE(HLTFiltCand);
 DEFINE_FWK_MODULE(HLTLevel1GTSeed);
@@ -154,12 +175,18 @@ DEFINE_FWK_MODULE(HLT1MET);
 DEFINE_FWK_MODULE(HLT1PFTau);
 DEFINE_FWK_MODULE(HLT1PFJet);
 
+DEFINE_FWK_MODULE(HLT1MultiElectron);
+DEFINE_FWK_MODULE(HLT1MultiPhoton);
+DEFINE_FWK_MODULE(HLT1MultiMuon);
+DEFINE_FWK_MODULE(HLT1MultiCaloJet);
+DEFINE_FWK_MODULE(HLT1MultiPFTau);
+DEFINE_FWK_MODULE(HLT1MultiPFJet);
+
 DEFINE_FWK_MODULE(HLTLevel1EG);
 DEFINE_FWK_MODULE(HLTLevel1MET);
 DEFINE_FWK_MODULE(HLTLevel1Jet);
 DEFINE_FWK_MODULE(HLTLevel1Muon);
 
-/*
 DEFINE_FWK_MODULE(HLT1SmartElectron);
 DEFINE_FWK_MODULE(HLT1SmartPhoton);
 DEFINE_FWK_MODULE(HLT1SmartMuon);
@@ -171,7 +198,6 @@ DEFINE_FWK_MODULE(HLT1SmartMET);
 //DEFINE_FWK_MODULE(HLT1SmartCluster);
 DEFINE_FWK_MODULE(HLT1SmartPFTau);
 DEFINE_FWK_MODULE(HLT1SmartPFJet);
-*/
 
 DEFINE_FWK_MODULE(HLTGlobalSumsCaloMET);
 DEFINE_FWK_MODULE(HLTGlobalSumsMET);
@@ -179,3 +205,10 @@ DEFINE_FWK_MODULE(HLTGlobalSumsMET);
 DEFINE_FWK_MODULE(HLT2ElectronElectronDZ);
 DEFINE_FWK_MODULE(HLT2MuonMuonDZ);
 DEFINE_FWK_MODULE(HLT2ElectronMuonDZ);
+
+DEFINE_FWK_MODULE(HLT3CaloJetCaloJetCaloJet);
+DEFINE_FWK_MODULE(HLT3PFJetPFJetPFJet);
+DEFINE_FWK_MODULE(HLT3MuonMuonCaloJet);
+DEFINE_FWK_MODULE(HLT3MuonMuonPFJet);
+DEFINE_FWK_MODULE(HLT3ElectronElectronCaloJet);
+DEFINE_FWK_MODULE(HLT3ElectronElectronPFJet);
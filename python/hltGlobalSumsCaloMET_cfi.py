@@ -6,6 +6,7 @@ hltGlobalSumsCaloMET= cms.EDFilter( "HLTGlobalSumsCaloMET",
     observable = cms.string( "sumEt" ),
     Min = cms.double( 30.0 ),
     Max = cms.double( -1.0 ),
-    MinN = cms.int32( 1 )
+    MinN = cms.int32( 1 ),
+    decisionOnly = cms.bool( False )
 )
 
@@ -6,6 +6,7 @@ hltGlobalSumsMET= cms.EDFilter( "HLTGlobalSumsMET",
     observable = cms.string( "sumEt" ),
     Min = cms.double( 100.0 ),
     Max = cms.double( -1.0 ),
-    MinN = cms.int32( 1 )
+    MinN = cms.int32( 1 ),
+    decisionOnly = cms.bool( False )
 )
 
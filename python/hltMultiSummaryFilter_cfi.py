@@ -0,0 +1,14 @@
+import FWCore.ParameterSet.Config as cms
+
+hltMultiSummaryFilter = cms.EDFilter("HLTMultiSummaryFilter",
+    summary = cms.InputTag("hltTriggerSummaryAOD","","HLT"), # trigger summary
+    saveTags = cms.bool( False ),
+    selections = cms.VPSet(
+        cms.PSet(
+            name    = cms.string("jet80"),                     # name of the decision
+            member  = cms.InputTag("hlt1jet30","","HLT"),      # filter or collection
+            cut     = cms.string("pt>80"),                     # cut on trigger object
+            minN    = cms.int32(1)                  # min. # of passing objects needed
+        ),
+    )
+)
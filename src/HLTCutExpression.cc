@@ -0,0 +1,618 @@
+/** \class HLTCutExpression
+ *
+ * See header file for documentation
+ *
+ *  \author Martin Grunewald
+ *
+ */
+
+#include "HLTrigger/HLTfilters/interface/HLTCutExpression.h"
+
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <cmath>
+#include <algorithm>
+
+//
+// constructors and destructor
+//
+HLTCutExpression::HLTCutExpression(const std::string & cut) :
+  cut_(cut),
+  position_(0),
+  valid_(false),
+  program_(),
+  variables_()
+{
+  skipSpaces();
+  if (position_ == cut_.size()) {
+    // an empty cut accepts everything
+    program_.push_back(Instruction(kConstant, 1.));
+    valid_ = true;
+    return;
+  }
+
+  valid_ = parseOr(program_);
+  skipSpaces();
+  valid_ = valid_ and (position_ == cut_.size()) and (variables_.size() <= kMaxVariables) and checkDepth();
+  if (not valid_) {
+    program_.clear();
+    variables_.clear();
+  }
+}
+
+//
+// member functions
+//
+
+std::string HLTCutExpression::normalize(const std::string & cut) {
+  std::string result;
+  result.reserve(cut.size());
+  char quote = 0;           // the quote character, inside a quoted string
+  bool space = false;       // whitespace has been skipped since the last character
+  for (std::string::const_iterator i = cut.begin(); i != cut.end(); ++i) {
+    if (quote) {
+      result += *i;
+      if (*i == quote)
+        quote = 0;
+      continue;
+    }
+    if (std::isspace(*i)) {
+      space = true;
+      continue;
+    }
+    // replace each run of whitespace between two tokens by a single space, which keeps the tokens apart
+    if (space and not result.empty())
+      result += ' ';
+    space = false;
+    if (*i == '"' or *i == '\'')
+      quote = *i;
+    result += *i;
+  }
+  return result;
+}
+
+bool HLTCutExpression::operator()(const double * values) const {
+  double stack[kMaxDepth];
+  unsigned int top = 0;     // number of values on the stack
+
+  for (Program::const_iterator i = program_.begin(); i != program_.end(); ++i) {
+    // operands
+    if (i->operation == kConstant) {
+      stack[top++] = i->value;
+      continue;
+    }
+    if (i->operation == kVariable) {
+      stack[top++] = values[i->index];
+      continue;
+    }
+
+    // unary operators and functions act on the top of the stack
+    double & a = stack[top - 1];
+    switch (i->operation) {
+      case kNegate:       a = - a; continue;
+      case kNot:          a = (a == 0.); continue;
+      case kAbs:          a = std::abs(a); continue;
+      case kSqrt:         a = std::sqrt(a); continue;
+      case kExp:          a = std::exp(a); continue;
+      case kLog:          a = std::log(a); continue;
+      case kLog10:        a = std::log10(a); continue;
+      case kSin:          a = std::sin(a); continue;
+      case kCos:          a = std::cos(a); continue;
+      case kTan:          a = std::tan(a); continue;
+      case kAsin:         a = std::asin(a); continue;
+      case kAcos:         a = std::acos(a); continue;
+      case kAtan:         a = std::atan(a); continue;
+      case kSinh:         a = std::sinh(a); continue;
+      case kCosh:         a = std::cosh(a); continue;
+      case kTanh:         a = std::tanh(a); continue;
+      default:            break;
+    }
+
+    // binary operators and functions replace the two values on the top of the stack with the result
+    const double b = stack[--top];
+    double & c = stack[top - 1];
+    switch (i->operation) {
+      case kAdd:          c = c + b; break;
+      case kSubtract:     c = c - b; break;
+      case kMultiply:     c = c * b; break;
+      case kDivide:       c = c / b; break;
+      case kPower:        c = std::pow(c, b); break;
+      case kLess:         c = (c <  b); break;
+      case kLessEqual:    c = (c <= b); break;
+      case kGreater:      c = (c >  b); break;
+      case kGreaterEqual: c = (c >= b); break;
+      case kEqual:        c = (c == b); break;
+      case kNotEqual:     c = (c != b); break;
+      case kAnd:          c = (c != 0.) and (b != 0.); break;
+      case kOr:           c = (c != 0.) or  (b != 0.); break;
+      case kAtan2:        c = std::atan2(c, b); break;
+      case kHypot:        c = std::sqrt(c * c + b * b); break;
+      case kMin:          c = std::min(c, b); break;
+      case kMax:          c = std::max(c, b); break;
+      default:            break;
+    }
+  }
+
+  // the program has been checked to leave exactly one value on the stack
+  return (stack[0] != 0.);
+}
+
+namespace {
+
+  // the operations, applied element by element when evaluating the cut on a whole collection
+  struct Negate       { static double apply(double a) { return - a;            } };
+  struct Not          { static double apply(double a) { return (a == 0.);      } };
+  struct Abs          { static double apply(double a) { return std::abs(a);    } };
+  struct Sqrt         { static double apply(double a) { return std::sqrt(a);   } };
+  struct Exp          { static double apply(double a) { return std::exp(a);    } };
+  struct Log          { static double apply(double a) { return std::log(a);    } };
+  struct Log10        { static double apply(double a) { return std::log10(a);  } };
+  struct Sin          { static double apply(double a) { return std::sin(a);    } };
+  struct Cos          { static double apply(double a) { return std::cos(a);    } };
+  struct Tan          { static double apply(double a) { return std::tan(a);    } };
+  struct Asin         { static double apply(double a) { return std::asin(a);   } };
+  struct Acos         { static double apply(double a) { return std::acos(a);   } };
+  struct Atan         { static double apply(double a) { return std::atan(a);   } };
+  struct Sinh         { static double apply(double a) { return std::sinh(a);   } };
+  struct Cosh         { static double apply(double a) { return std::cosh(a);   } };
+  struct Tanh         { static double apply(double a) { return std::tanh(a);   } };
+
+  struct Add          { static double apply(double a, double b) { return a + b;                       } };
+  struct Subtract     { static double apply(double a, double b) { return a - b;                       } };
+  struct Multiply     { static double apply(double a, double b) { return a * b;                       } };
+  struct Divide       { static double apply(double a, double b) { return a / b;                       } };
+  struct Power        { static double apply(double a, double b) { return std::pow(a, b);              } };
+  struct Less         { static double apply(double a, double b) { return (a <  b);                    } };
+  struct LessEqual    { static double apply(double a, double b) { return (a <= b);                    } };
+  struct Greater      { static double apply(double a, double b) { return (a >  b);                    } };
+  struct GreaterEqual { static double apply(double a, double b) { return (a >= b);                    } };
+  struct Equal        { static double apply(double a, double b) { return (a == b);                    } };
+  struct NotEqual     { static double apply(double a, double b) { return (a != b);                    } };
+  struct And          { static double apply(double a, double b) { return (a != 0.) & (b != 0.);       } };
+  struct Or           { static double apply(double a, double b) { return (a != 0.) | (b != 0.);       } };
+  struct Atan2        { static double apply(double a, double b) { return std::atan2(a, b);            } };
+  struct Hypot        { static double apply(double a, double b) { return std::sqrt(a * a + b * b);    } };
+  struct Min          { static double apply(double a, double b) { return std::min(a, b);              } };
+  struct Max          { static double apply(double a, double b) { return std::max(a, b);              } };
+
+  template<typename OP>
+  void unary(const double * a, double * out, unsigned int size) {
+    for (unsigned int i = 0; i != size; ++i)
+      out[i] = OP::apply(a[i]);
+  }
+
+  // the variants with a constant operand avoid filling a column with the same value
+  template<typename OP>
+  void binary(const double * a, const double * b, double * out, unsigned int size) {
+    for (unsigned int i = 0; i != size; ++i)
+      out[i] = OP::apply(a[i], b[i]);
+  }
+
+  template<typename OP>
+  void binary(const double * a, double b, double * out, unsigned int size) {
+    for (unsigned int i = 0; i != size; ++i)
+      out[i] = OP::apply(a[i], b);
+  }
+
+  template<typename OP>
+  void binary(double a, const double * b, double * out, unsigned int size) {
+    for (unsigned int i = 0; i != size; ++i)
+      out[i] = OP::apply(a, b[i]);
+  }
+
+  template<typename OP>
+  void unary(double & a_value, const double * a, double * out, unsigned int size) {
+    if (a)
+      unary<OP>(a, out, size);
+    else
+      a_value = OP::apply(a_value);
+  }
+
+  template<typename OP>
+  void binary(double & a_value, const double * a, double b_value, const double * b, double * out, unsigned int size) {
+    if (a and b)
+      binary<OP>(a, b, out, size);
+    else if (a)
+      binary<OP>(a, b_value, out, size);
+    else if (b)
+      binary<OP>(a_value, b, out, size);
+    else
+      a_value = OP::apply(a_value, b_value);
+  }
+
+}
+
+void HLTCutExpression::operator()(const double * const * columns, unsigned int size, Workspace & workspace, std::vector<unsigned char> & pass) const {
+  pass.resize(size);
+  if (size == 0)
+    return;
+
+  workspace.stack.resize(kMaxDepth);
+  int unused[kMaxDepth];    // buffers not in use
+  unsigned int nunused = 0;
+  for (unsigned int i = 0; i != kMaxDepth; ++i)
+    unused[nunused++] = kMaxDepth - 1 - i;
+
+  Slot stack[kMaxDepth];
+  unsigned int top = 0;     // number of slots on the stack
+
+  for (Program::const_iterator i = program_.begin(); i != program_.end(); ++i) {
+    // operands
+    if (i->operation == kConstant) {
+      Slot & slot = stack[top++];
+      slot.data   = 0;
+      slot.value  = i->value;
+      slot.buffer = -1;
+      continue;
+    }
+    if (i->operation == kVariable) {
+      Slot & slot = stack[top++];
+      slot.data   = columns[i->index];
+      slot.value  = 0.;
+      slot.buffer = -1;
+      continue;
+    }
+
+    // unary operators and functions act on the top of the stack, in place if it is held in a buffer
+    if (isUnary(i->operation)) {
+      Slot & a = stack[top - 1];
+      int result = -1;
+      double * out = 0;
+      if (a.data) {
+        result = (a.buffer >= 0) ? a.buffer : unused[--nunused];
+        workspace.stack[result].resize(size);
+        out = & workspace.stack[result].front();
+      }
+      switch (i->operation) {
+        case kNegate:       unary<Negate>(a.value, a.data, out, size); break;
+        case kNot:          unary<Not>   (a.value, a.data, out, size); break;
+        case kAbs:          unary<Abs>   (a.value, a.data, out, size); break;
+        case kSqrt:         unary<Sqrt>  (a.value, a.data, out, size); break;
+        case kExp:          unary<Exp>   (a.value, a.data, out, size); break;
+        case kLog:          unary<Log>   (a.value, a.data, out, size); break;
+        case kLog10:        unary<Log10> (a.value, a.data, out, size); break;
+        case kSin:          unary<Sin>   (a.value, a.data, out, size); break;
+        case kCos:          unary<Cos>   (a.value, a.data, out, size); break;
+        case kTan:          unary<Tan>   (a.value, a.data, out, size); break;
+        case kAsin:         unary<Asin>  (a.value, a.data, out, size); break;
+        case kAcos:         unary<Acos>  (a.value, a.data, out, size); break;
+        case kAtan:         unary<Atan>  (a.value, a.data, out, size); break;
+        case kSinh:         unary<Sinh>  (a.value, a.data, out, size); break;
+        case kCosh:         unary<Cosh>  (a.value, a.data, out, size); break;
+        case kTanh:         unary<Tanh>  (a.value, a.data, out, size); break;
+        default:            break;
+      }
+      if (out) {
+        a.data   = out;
+        a.buffer = result;
+      }
+      continue;
+    }
+
+    // binary operators and functions replace the two slots on the top of the stack with the result,
+    // held in place in one of their buffers if any
+    const Slot b = stack[--top];
+    Slot & c = stack[top - 1];
+    int result = -1;
+    double * out = 0;
+    if (c.data or b.data) {
+      result = (c.buffer >= 0) ? c.buffer : (b.buffer >= 0) ? b.buffer : unused[--nunused];
+      workspace.stack[result].resize(size);
+      out = & workspace.stack[result].front();
+    }
+    switch (i->operation) {
+      case kAdd:          binary<Add>         (c.value, c.data, b.value, b.data, out, size); break;
+      case kSubtract:     binary<Subtract>    (c.value, c.data, b.value, b.data, out, size); break;
+      case kMultiply:     binary<Multiply>    (c.value, c.data, b.value, b.data, out, size); break;
+      case kDivide:       binary<Divide>      (c.value, c.data, b.value, b.data, out, size); break;
+      case kPower:        binary<Power>       (c.value, c.data, b.value, b.data, out, size); break;
+      case kLess:         binary<Less>        (c.value, c.data, b.value, b.data, out, size); break;
+      case kLessEqual:    binary<LessEqual>   (c.value, c.data, b.value, b.data, out, size); break;
+      case kGreater:      binary<Greater>     (c.value, c.data, b.value, b.data, out, size); break;
+      case kGreaterEqual: binary<GreaterEqual>(c.value, c.data, b.value, b.data, out, size); break;
+      case kEqual:        binary<Equal>       (c.value, c.data, b.value, b.data, out, size); break;
+      case kNotEqual:     binary<NotEqual>    (c.value, c.data, b.value, b.data, out, size); break;
+      case kAnd:          binary<And>         (c.value, c.data, b.value, b.data, out, size); break;
+      case kOr:           binary<Or>          (c.value, c.data, b.value, b.data, out, size); break;
+      case kAtan2:        binary<Atan2>       (c.value, c.data, b.value, b.data, out, size); break;
+      case kHypot:        binary<Hypot>       (c.value, c.data, b.value, b.data, out, size); break;
+      case kMin:          binary<Min>         (c.value, c.data, b.value, b.data, out, size); break;
+      case kMax:          binary<Max>         (c.value, c.data, b.value, b.data, out, size); break;
+      default:            break;
+    }
+    if (out) {
+      // release the buffer of the operand not used for the result
+      if (c.buffer >= 0 and c.buffer != result) unused[nunused++] = c.buffer;
+      if (b.buffer >= 0 and b.buffer != result) unused[nunused++] = b.buffer;
+      c.data   = out;
+      c.buffer = result;
+    }
+  }
+
+  // the program has been checked to leave exactly one slot on the stack
+  const Slot & last = stack[0];
+  if (last.data) {
+    for (unsigned int i = 0; i != size; ++i)
+      pass[i] = (last.data[i] != 0.);
+  } else {
+    pass.assign(size, last.value != 0.);
+  }
+}
+
+// or := and { ("||" | "|") and }
+bool HLTCutExpression::parseOr(Program & program) {
+  if (not parseAnd(program))
+    return false;
+  while (accept("||") or accept("|")) {
+    if (not parseAnd(program))
+      return false;
+    program.push_back(Instruction(kOr));
+  }
+  return true;
+}
+
+// and := not { ("&&" | "&") not }
+bool HLTCutExpression::parseAnd(Program & program) {
+  if (not parseNot(program))
+    return false;
+  while (accept("&&") or accept("&")) {
+    if (not parseNot(program))
+      return false;
+    program.push_back(Instruction(kAnd));
+  }
+  return true;
+}
+
+// not := "!" not | comparison
+bool HLTCutExpression::parseNot(Program & program) {
+  skipSpaces();
+  if (cut_.compare(position_, 1, "!") == 0 and cut_.compare(position_, 2, "!=") != 0) {
+    ++position_;
+    if (not parseNot(program))
+      return false;
+    program.push_back(Instruction(kNot));
+    return true;
+  }
+  return parseComparison(program);
+}
+
+// comparison := sum [ ("<=" | ">=" | "<" | ">" | "==" | "!=" | "=") sum [ ("<=" | ... ) sum ] ]
+// a trinary comparison, as in "-3<eta<3", is the logical and of the two comparisons;
+// as in StringCutObjectSelector, longer chains are not supported
+bool HLTCutExpression::parseComparison(Program & program) {
+  std::vector<Program>   operands(1);
+  std::vector<Operation> operations;
+  if (not parseSum(operands.back()))
+    return false;
+  while (true) {
+    Operation operation;
+    if      (accept("<=")) operation = kLessEqual;
+    else if (accept(">=")) operation = kGreaterEqual;
+    else if (accept("==")) operation = kEqual;
+    else if (accept("!=")) operation = kNotEqual;
+    else if (accept("<"))  operation = kLess;
+    else if (accept(">"))  operation = kGreater;
+    else if (accept("="))  operation = kEqual;
+    else break;
+    if (operations.size() == 2)
+      return false;
+    operations.push_back(operation);
+    operands.push_back(Program());
+    if (not parseSum(operands.back()))
+      return false;
+  }
+
+  if (operations.empty()) {
+    program.insert(program.end(), operands[0].begin(), operands[0].end());
+    return true;
+  }
+  for (unsigned int i = 0; i != operations.size(); ++i) {
+    program.insert(program.end(), operands[i].begin(),   operands[i].end());
+    program.insert(program.end(), operands[i+1].begin(), operands[i+1].end());
+    program.push_back(Instruction(operations[i]));
+    if (i > 0)
+      program.push_back(Instruction(kAnd));
+  }
+  return true;
+}
+
+// sum := product { ("+" | "-") product }
+bool HLTCutExpression::parseSum(Program & program) {
+  if (not parseProduct(program))
+    return false;
+  while (true) {
+    Operation operation;
+    if      (accept("+")) operation = kAdd;
+    else if (accept("-")) operation = kSubtract;
+    else break;
+    if (not parseProduct(program))
+      return false;
+    program.push_back(Instruction(operation));
+  }
+  return true;
+}
+
+// product := power { ("*" | "/") power }
+bool HLTCutExpression::parseProduct(Program & program) {
+  if (not parsePower(program))
+    return false;
+  while (true) {
+    Operation operation;
+    if      (accept("*")) operation = kMultiply;
+    else if (accept("/")) operation = kDivide;
+    else break;
+    if (not parsePower(program))
+      return false;
+    program.push_back(Instruction(operation));
+  }
+  return true;
+}
+
+// power := unary { "^" unary }
+// as in StringCutObjectSelector, "^" is left-associative, and binds looser than the unary operators
+bool HLTCutExpression::parsePower(Program & program) {
+  if (not parseUnary(program))
+    return false;
+  while (accept("^")) {
+    if (not parseUnary(program))
+      return false;
+    program.push_back(Instruction(kPower));
+  }
+  return true;
+}
+
+// unary := ("-" | "+") unary | primary
+bool HLTCutExpression::parseUnary(Program & program) {
+  if (accept("-")) {
+    if (not parseUnary(program))
+      return false;
+    program.push_back(Instruction(kNegate));
+    return true;
+  }
+  if (accept("+"))
+    return parseUnary(program);
+  return parsePrimary(program);
+}
+
+// primary := number | "(" or ")" | function "(" or [ "," or ] ")" | variable [ "(" ")" ]
+bool HLTCutExpression::parsePrimary(Program & program) {
+  double value;
+  if (parseNumber(value)) {
+    program.push_back(Instruction(kConstant, value));
+    return true;
+  }
+
+  if (accept("(")) {
+    return parseOr(program) and accept(")");
+  }
+
+  std::string name;
+  if (not parseIdentifier(name))
+    return false;
+
+  if (not accept("(")) {
+    // a method without parentheses; chained methods are not supported
+    skipSpaces();
+    if (cut_.compare(position_, 1, ".") == 0)
+      return false;
+    program.push_back(Instruction(kVariable, 0., variable(name)));
+    return true;
+  }
+
+  if (accept(")")) {
+    // a method with empty parentheses; chained methods are not supported
+    skipSpaces();
+    if (cut_.compare(position_, 1, ".") == 0)
+      return false;
+    program.push_back(Instruction(kVariable, 0., variable(name)));
+    return true;
+  }
+
+  // functions of one argument
+  static const char * const      unaryNames[] = { "abs", "sqrt", "exp", "log", "log10", "sin", "cos", "tan", "asin", "acos", "atan", "sinh", "cosh", "tanh" };
+  static const Operation    unaryOperations[] = {  kAbs,  kSqrt,  kExp,  kLog,  kLog10,  kSin,  kCos,  kTan,  kAsin,  kAcos,  kAtan,  kSinh,  kCosh,  kTanh  };
+  for (unsigned int i = 0; i != sizeof(unaryNames) / sizeof(unaryNames[0]); ++i) {
+    if (name == unaryNames[i]) {
+      if (not (parseOr(program) and accept(")")))
+        return false;
+      program.push_back(Instruction(unaryOperations[i]));
+      return true;
+    }
+  }
+
+  // functions of two arguments
+  static const char * const     binaryNames[] = { "atan2", "hypot", "min", "max", "pow"  };
+  static const Operation   binaryOperations[] = {  kAtan2,  kHypot,  kMin,  kMax,  kPower };
+  for (unsigned int i = 0; i != sizeof(binaryNames) / sizeof(binaryNames[0]); ++i) {
+    if (name == binaryNames[i]) {
+      if (not (parseOr(program) and accept(",") and parseOr(program) and accept(")")))
+        return false;
+      program.push_back(Instruction(binaryOperations[i]));
+      return true;
+    }
+  }
+
+  // methods with arguments, and unknown functions, are not supported
+  return false;
+}
+
+void HLTCutExpression::skipSpaces() {
+  while (position_ < cut_.size() and std::isspace(cut_[position_]))
+    ++position_;
+}
+
+bool HLTCutExpression::accept(const char * token) {
+  skipSpaces();
+  if (cut_.compare(position_, std::strlen(token), token) != 0)
+    return false;
+  position_ += std::strlen(token);
+  return true;
+}
+
+bool HLTCutExpression::parseNumber(double & value) {
+  skipSpaces();
+  if (position_ == cut_.size() or not (std::isdigit(cut_[position_]) or cut_[position_] == '.'))
+    return false;
+  const char * begin = cut_.c_str() + position_;
+  char * end;
+  value = std::strtod(begin, & end);
+  if (end == begin)
+    return false;
+  position_ += end - begin;
+  return true;
+}
+
+bool HLTCutExpression::parseIdentifier(std::string & name) {
+  skipSpaces();
+  if (position_ == cut_.size() or not (std::isalpha(cut_[position_]) or cut_[position_] == '_'))
+    return false;
+  const std::string::size_type begin = position_;
+  while (position_ < cut_.size() and (std::isalnum(cut_[position_]) or cut_[position_] == '_'))
+    ++position_;
+  name = cut_.substr(begin, position_ - begin);
+  return true;
+}
+
+unsigned int HLTCutExpression::variable(const std::string & name) {
+  std::vector<std::string>::const_iterator i = std::find(variables_.begin(), variables_.end(), name);
+  if (i != variables_.end())
+    return i - variables_.begin();
+  variables_.push_back(name);
+  return variables_.size() - 1;
+}
+
+bool HLTCutExpression::checkDepth() const {
+  unsigned int depth = 0;
+  for (Program::const_iterator i = program_.begin(); i != program_.end(); ++i) {
+    switch (i->operation) {
+      case kConstant:
+      case kVariable:
+        if (++depth > kMaxDepth)
+          return false;
+        break;
+
+      default:
+        if (isUnary(i->operation)) {
+          if (depth < 1)
+            return false;
+        } else {
+          if (depth < 2)
+            return false;
+          --depth;
+        }
+    }
+  }
+  return (depth == 1);
+}
+
+bool HLTCutExpression::isUnary(Operation operation) {
+  switch (operation) {
+    case kNegate: case kNot:
+    case kAbs: case kSqrt: case kExp: case kLog: case kLog10: case kSin: case kCos: case kTan:
+    case kAsin: case kAcos: case kAtan: case kSinh: case kCosh: case kTanh:
+      return true;
+    default:
+      return false;
+  }
+}
@@ -17,11 +17,12 @@
 #include "DataFormats/Common/interface/Ref.h"
 #include "DataFormats/HLTReco/interface/TriggerFilterObjectWithRefs.h"
 
-#include "DataFormats/Candidate/interface/Particle.h"
-
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
 #include<cmath>
+#include<memory>
+#include<limits>
+#include<algorithm>
 
 //
 // constructors and destructor
@@ -45,20 +46,57 @@ HLTDoublet<T1,T2>::HLTDoublet(const edm::ParameterSet& iConfig) : HLTFilter(iCon
   min_Pt_   (iConfig.template getParameter<double>("MinPt")),
   max_Pt_   (iConfig.template getParameter<double>("MaxPt")),
   min_N_    (iConfig.template getParameter<int>("MinN")),
+  uniqueObjects_(iConfig.template getParameter<bool>("uniqueObjects")),
+  savePairs_(iConfig.template getParameter<bool>("savePairs")),
+  decisionOnly_(iConfig.template getParameter<bool>("decisionOnly")),
+  cuts_(),
   label_    (iConfig.getParameter<std::string>("@module_label")),
   coll1_(),
-  coll2_()
+  coll2_(),
+  columns1_(),
+  columns2_(),
+  collectionTags_(),
+  tags_(),
+  saved1_(),
+  saved2_(),
+  eta2_(),
+  window2_()
 {
 
    // same collections to be compared?
    same_ = (inputTag1_.encode()==inputTag2_.encode());
 
+   // indices of the objects of the passing pairs
+   if (savePairs_) produces<std::vector<unsigned int> >();
+
    cutdphi_ = (min_Dphi_ <= max_Dphi_); // cut active?
    cutdeta_ = (min_Deta_ <= max_Deta_); // cut active?
    cutminv_ = (min_Minv_ <= max_Minv_); // cut active?
    cutdelr_ = (min_DelR_ <= max_DelR_); // cut active?
    cutpt_   = (min_Pt_   <= max_Pt_  ); // cut active?
 
+   // both a Deta and a DelR window limit the |Deta| of the pairs to be considered
+   window_  = cutdeta_ || cutdelr_;
+   max_eta_ = std::numeric_limits<double>::infinity();
+   if (cutdeta_) max_eta_ = std::min(max_eta_, max_Deta_);
+   if (cutdelr_) max_eta_ = std::min(max_eta_, max_DelR_);
+
+   // the DelR window is checked on DelR^2; as DelR is not negative, a negative bound is replaced by -1
+   min_DelR2_ = (min_DelR_ > 0.) ? min_DelR_*min_DelR_ : -1.;
+   max_DelR2_ = (max_DelR_ < 0.) ? -1. : max_DelR_*max_DelR_;
+
+   // the active cuts, in the order they are checked: the cheapest first, and those needing the pair momentum last
+   if (cutdeta_) cuts_.push_back(kDeta);
+   if (cutdphi_) cuts_.push_back(kDphi);
+   if (cutdelr_) cuts_.push_back(kDelR);
+   if (cutpt_  ) cuts_.push_back(kPt  );
+   if (cutminv_) cuts_.push_back(kMinv);
+
+   // the variables needed by the cuts
+   groups_ = 0;
+   if (cutdeta_ || cutdphi_ || cutdelr_) groups_ |= HLTObjectColumns::kDirection;
+   if (cutpt_ || cutminv_)               groups_ |= HLTObjectColumns::kMomentum;
+
    LogDebug("") << "InputTags and cuts : " 
 		<< inputTag1_.encode() << " " << inputTag2_.encode()
 		<< triggerType1_ << " " << triggerType2_
@@ -99,6 +137,9 @@ HLTDoublet<T1,T2>::fillDescriptions(edm::ConfigurationDescriptions& descriptions
   desc.add<double>("MinPt"  ,+1.0);
   desc.add<double>("MaxPt"  ,-1.0);
   desc.add<int>("MinN",1);
+  desc.add<bool>("uniqueObjects",false);
+  desc.add<bool>("savePairs",false);
+  desc.add<bool>("decisionOnly",false);
   descriptions.add(std::string("hlt")+std::string(typeid(HLTDoublet<T1,T2>).name()),desc);
 }
 
@@ -121,6 +162,7 @@ HLTDoublet<T1,T2>::hltFilter(edm::Event& iEvent, const edm::EventSetup& iSetup,
    // this HLT filter, and place it in the Event.
 
    bool accept(false);
+   auto_ptr<vector<unsigned int> > pairs(new vector<unsigned int>());
 
    LogVerbatim("HLTDoublet") << " XXX " << label_ << " 0 " << std::endl;
 
@@ -135,78 +177,181 @@ HLTDoublet<T1,T2>::hltFilter(edm::Event& iEvent, const edm::EventSetup& iSetup,
      const size_type n2(coll2_.size());
 
      if (saveTags()) {
-       InputTag tagOld;
        filterproduct.addCollectionTag(originTag1_);
        LogVerbatim("HLTDoublet") << " XXX " << label_ << " 1a " << originTag1_.encode() << std::endl;
-       tagOld=InputTag();
-       for (size_type i1=0; i1!=n1; ++i1) {
-	 const ProductID pid(coll1_[i1].id());
-	 const string&    label(iEvent.getProvenance(pid).moduleLabel());
-	 const string& instance(iEvent.getProvenance(pid).productInstanceName());
-	 const string&  process(iEvent.getProvenance(pid).processName());
-	 InputTag tagNew(InputTag(label,instance,process));
-	 if (tagOld.encode()!=tagNew.encode()) {
-	   filterproduct.addCollectionTag(tagNew);
-	   tagOld=tagNew;
-	   LogVerbatim("HLTDoublet") << " XXX " << label_ << " 1b " << tagNew.encode() << std::endl;
-	 }
+       collectionTags_.tags(iEvent,coll1_,tags_);
+       for (unsigned int i=0; i!=tags_.size(); ++i) {
+	 filterproduct.addCollectionTag(tags_[i]);
+	 LogVerbatim("HLTDoublet") << " XXX " << label_ << " 1b " << tags_[i].encode() << std::endl;
        }
        filterproduct.addCollectionTag(originTag2_);
        LogVerbatim("HLTDoublet") << " XXX " << label_ << " 2a " << originTag2_.encode() << std::endl;
-       tagOld=InputTag();
-       for (size_type i2=0; i2!=n2; ++i2) {
-	 const ProductID pid(coll2_[i2].id());
-	 const string&    label(iEvent.getProvenance(pid).moduleLabel());
-	 const string& instance(iEvent.getProvenance(pid).productInstanceName());
-	 const string&  process(iEvent.getProvenance(pid).processName());
-	 InputTag tagNew(InputTag(label,instance,process));
-	 if (tagOld.encode()!=tagNew.encode()) {
-	   filterproduct.addCollectionTag(tagNew);
-	   tagOld=tagNew;
-	   LogVerbatim("HLTDoublet") << " XXX " << label_ << " 2b " << tagNew.encode() << std::endl;
-	 }
+       collectionTags_.tags(iEvent,coll2_,tags_);
+       for (unsigned int i=0; i!=tags_.size(); ++i) {
+	 filterproduct.addCollectionTag(tags_[i]);
+	 LogVerbatim("HLTDoublet") << " XXX " << label_ << " 2b " << tags_[i].encode() << std::endl;
+       }
+     }
+
+     // resolve the Refs once, into contiguous arrays of the variables needed by the cuts
+     columns1_.fill(coll1_,groups_);
+     columns2_.fill(coll2_,groups_);
+
+     // index the 2nd objects by eta, to consider only those within the eta window of each 1st object;
+     // the window is slightly enlarged, so that rounding can not exclude any pair passing the actual cuts
+     const double margin(1.e-6);
+     if (window_) {
+       eta2_.clear();
+       for (unsigned int i2=0; i2!=n2; i2++) {
+	 const double eta(columns2_.eta[i2]);
+	 if (eta==eta) eta2_.push_back(make_pair(eta,i2));   // objects with an undefined eta can not pass the window
        }
+       sort(eta2_.begin(),eta2_.end());
+     }
+
+     if (uniqueObjects_) {
+       saved1_.assign(n1,false);
+       saved2_.assign(n2,false);
      }
 
      int n(0);
-     T1Ref r1;
-     T2Ref r2;
-     Particle::LorentzVector p1,p2,p;
-     for (unsigned int i1=0; i1!=n1; i1++) {
-       r1=coll1_[i1];
-       p1=r1->p4();
+     unsigned int block2[kBlock];    // indices of a block of 2nd objects
+     unsigned char pass[kBlock];     // pairs passing the cuts, for a block of 2nd objects
+     // if the objects are not used downstream, stop as soon as enough pairs pass the cuts
+     for (unsigned int i1=0; (i1!=n1) && !(decisionOnly_ && n>=min_N_); i1++) {
        unsigned int I(0);
        if (same_) {I=i1+1;}
-       for (unsigned int i2=I; i2!=n2; i2++) {
-	 r2=coll2_[i2];
-	 p2=r2->p4();
-
-	 double Dphi(std::abs(p1.phi()-p2.phi()));
-	 if (Dphi>M_PI) Dphi=2.0*M_PI-Dphi;
-	 
-	 double Deta(std::abs(p1.eta()-p2.eta()));
-	 
-	 p=p1+p2;
-	 double Minv(std::abs(p.mass()));
-	 double Pt(p.pt());
-
-	 double DelR(sqrt(Dphi*Dphi+Deta*Deta));
-	 
-	 if ( ( (!cutdphi_) || ((min_Dphi_<=Dphi) && (Dphi<=max_Dphi_)) ) &&
-	      ( (!cutdeta_) || ((min_Deta_<=Deta) && (Deta<=max_Deta_)) ) &&
-	      ( (!cutminv_) || ((min_Minv_<=Minv) && (Minv<=max_Minv_)) ) &&
-              ( (!cutdelr_) || ((min_DelR_<=DelR) && (DelR<=max_DelR_)) ) &&
-              ( (!cutpt_  ) || ((min_Pt_  <=Pt  ) && (Pt  <=max_Pt_  )) ) ) {
-	   n++;
-	   filterproduct.addObject(triggerType1_,r1);
-	   filterproduct.addObject(triggerType2_,r2);
+
+       // the 2nd objects to be considered, in increasing order
+       unsigned int m(I<n2 ? n2-I : 0);
+       if (window_) {
+	 const double eta1(columns1_.eta[i1]);
+	 if (eta1!=eta1) continue;   // an undefined eta can not pass the window
+	 vector<pair<double,unsigned int> >::iterator lower(lower_bound(eta2_.begin(),eta2_.end(),make_pair(eta1-max_eta_-margin,0u)));
+	 vector<pair<double,unsigned int> >::iterator upper(upper_bound(lower,eta2_.end(),make_pair(eta1+max_eta_+margin,numeric_limits<unsigned int>::max())));
+	 window2_.clear();
+	 for (; lower!=upper; ++lower)
+	   if (lower->second>=I) window2_.push_back(lower->second);
+	 sort(window2_.begin(),window2_.end());
+	 m=window2_.size();
+       }
+
+       // check the cuts on a block of pairs at a time, then record the passing ones
+       for (unsigned int k=0; (k<m) && !(decisionOnly_ && n>=min_N_); k+=kBlock) {
+	 const unsigned int size(m-k<kBlock ? m-k : kBlock);
+	 for (unsigned int j=0; j!=size; ++j)
+	   block2[j] = window_ ? window2_[k+j] : I+k+j;
+	 selectPairs(i1,block2,size,pass);
+	 for (unsigned int j=0; j!=size; ++j) {
+	   if (pass[j]) {
+	     n++;
+	     if (not decisionOnly_) addPair(i1,block2[j],filterproduct,*pairs);
+	   }
 	 }
-	 
        }
      }
      // filter decision
      accept = (n>=min_N_);
    }
 
+   if (savePairs_) iEvent.put(pairs);
+
    return accept;
 }
+
+// ------------ check the cuts on the pairs of the 1st object i1 with a block of 2nd objects ------------
+template<typename T1, typename T2>
+void
+HLTDoublet<T1,T2>::selectPairs(unsigned int i1, const unsigned int * i2, unsigned int size, unsigned char * pass) const
+{
+   // the cuts are checked in order, each on the whole block, in loops without branches;
+   // the variables are computed only when needed, and the remaining cuts are skipped once no pair passes
+   double Deta[kBlock], Dphi[kBlock];
+   double px[kBlock], py[kBlock];
+   const HLTObjectColumns & c1(columns1_);
+   const HLTObjectColumns & c2(columns2_);
+
+   for (unsigned int j=0; j!=size; ++j)
+     pass[j] = 1;
+
+   for (unsigned int c=0; c!=cuts_.size(); ++c) {
+     switch (cuts_[c]) {
+     case kDeta:
+       for (unsigned int j=0; j!=size; ++j) {
+	 Deta[j] = std::abs(c1.eta[i1]-c2.eta[i2[j]]);
+	 pass[j] &= (min_Deta_<=Deta[j]) & (Deta[j]<=max_Deta_);
+       }
+       break;
+     case kDphi:
+       for (unsigned int j=0; j!=size; ++j) {
+	 const double dphi(std::abs(c1.phi[i1]-c2.phi[i2[j]]));
+	 Dphi[j] = (dphi>M_PI) ? 2.0*M_PI-dphi : dphi;
+	 pass[j] &= (min_Dphi_<=Dphi[j]) & (Dphi[j]<=max_Dphi_);
+       }
+       break;
+     case kDelR:
+       // Deta and Dphi have already been computed if they are cut on
+       for (unsigned int j=0; j!=size; ++j) {
+	 if (!cutdeta_) Deta[j] = std::abs(c1.eta[i1]-c2.eta[i2[j]]);
+	 if (!cutdphi_) {
+	   const double dphi(std::abs(c1.phi[i1]-c2.phi[i2[j]]));
+	   Dphi[j] = (dphi>M_PI) ? 2.0*M_PI-dphi : dphi;
+	 }
+	 const double DelR2(Dphi[j]*Dphi[j]+Deta[j]*Deta[j]);
+	 pass[j] &= (min_DelR2_<=DelR2) & (DelR2<=max_DelR2_);
+       }
+       break;
+     case kPt:
+       for (unsigned int j=0; j!=size; ++j) {
+	 px[j] = c1.px[i1]+c2.px[i2[j]];
+	 py[j] = c1.py[i1]+c2.py[i2[j]];
+	 const double Pt(std::sqrt(px[j]*px[j]+py[j]*py[j]));
+	 pass[j] &= (min_Pt_<=Pt) & (Pt<=max_Pt_);
+       }
+       break;
+     case kMinv:
+       // the transverse momentum of the pair has already been computed if it is cut on
+       for (unsigned int j=0; j!=size; ++j) {
+	 if (!cutpt_) {
+	   px[j] = c1.px[i1]+c2.px[i2[j]];
+	   py[j] = c1.py[i1]+c2.py[i2[j]];
+	 }
+	 const double pz(c1.pz[i1]+c2.pz[i2[j]]);
+	 const double E (c1.energy[i1]+c2.energy[i2[j]]);
+	 const double Minv(std::sqrt(std::abs(E*E-px[j]*px[j]-py[j]*py[j]-pz*pz)));
+	 pass[j] &= (min_Minv_<=Minv) & (Minv<=max_Minv_);
+       }
+       break;
+     }
+
+     unsigned char any(0);
+     for (unsigned int j=0; j!=size; ++j)
+       any |= pass[j];
+     if (!any) break;
+   }
+}
+
+// ------------ record the objects of a passing pair ------------
+template<typename T1, typename T2>
+void
+HLTDoublet<T1,T2>::addPair(unsigned int i1, unsigned int i2, trigger::TriggerFilterObjectWithRefs & filterproduct, std::vector<unsigned int> & pairs)
+{
+   if (not uniqueObjects_) {
+     filterproduct.addObject(triggerType1_,coll1_[i1]);
+     filterproduct.addObject(triggerType2_,coll2_[i2]);
+   } else {
+     // each object is recorded only the first time it is part of a passing pair
+     if (not saved1_[i1]) {
+       filterproduct.addObject(triggerType1_,coll1_[i1]);
+       saved1_[i1] = true;
+     }
+     if (not saved2_[i2]) {
+       filterproduct.addObject(triggerType2_,coll2_[i2]);
+       saved2_[i2] = true;
+     }
+   }
+   if (savePairs_) {
+     pairs.push_back(i1);
+     pairs.push_back(i2);
+   }
+}
@@ -6,13 +6,12 @@
 #include "DataFormats/Common/interface/Ref.h"
 #include "DataFormats/HLTReco/interface/TriggerFilterObjectWithRefs.h"
 
-#include "DataFormats/Candidate/interface/Particle.h"
-
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
-#include "DataFormats/Math/interface/deltaR.h"
-
 #include<cmath>
+#include<limits>
+#include<algorithm>
+#include<memory>
 
 //
 // constructors and destructor
@@ -28,13 +27,35 @@ HLTDoubletDZ<T1,T2>::HLTDoubletDZ(const edm::ParameterSet& iConfig) : HLTFilter(
   minDR_ (iConfig.template getParameter<double>("MinDR")),
   maxDZ_ (iConfig.template getParameter<double>("MaxDZ")),
   min_N_    (iConfig.template getParameter<int>("MinN")),
+  uniqueObjects_(iConfig.template getParameter<bool>("uniqueObjects")),
+  savePairs_(iConfig.template getParameter<bool>("savePairs")),
+  decisionOnly_(iConfig.template getParameter<bool>("decisionOnly")),
   checkSC_  (iConfig.template getParameter<bool>("checkSC")),
   label_    (iConfig.getParameter<std::string>("@module_label")),
   coll1_(),
-  coll2_()
+  coll2_(),
+  columns1_(),
+  columns2_(),
+  collectionTags_(),
+  tags_(),
+  saved1_(),
+  saved2_(),
+  vz2_(),
+  undefined2_(),
+  window2_()
 {
    // same collections to be compared?
    same_ = (inputTag1_.encode()==inputTag2_.encode());
+
+   // indices of the objects of the passing pairs
+   if (savePairs_) produces<std::vector<unsigned int> >();
+
+   // the DeltaR cut is checked on DeltaR^2
+   minDR2_ = minDR_*minDR_;
+
+   // the variables needed by the cuts
+   groups_ = HLTObjectColumns::kVertex;
+   if (minDR_ > 0.) groups_ |= HLTObjectColumns::kDirection;
 }
 
 template<typename T1, typename T2>
@@ -57,6 +78,9 @@ HLTDoubletDZ<T1,T2>::fillDescriptions(edm::ConfigurationDescriptions& descriptio
   desc.add<double>("MaxDZ",0.2);
   desc.add<bool>("checkSC",false);
   desc.add<int>("MinN",1);
+  desc.add<bool>("uniqueObjects",false);
+  desc.add<bool>("savePairs",false);
+  desc.add<bool>("decisionOnly",false);
   descriptions.add(std::string("hlt")+std::string(typeid(HLTDoubletDZ<T1,T2>).name()),desc);
 }
 
@@ -75,6 +99,7 @@ HLTDoubletDZ<T1,T2>::hltFilter(edm::Event& iEvent, const edm::EventSetup& iSetup
    // this HLT filter, and place it in the Event.
 
    bool accept(false);
+   auto_ptr<vector<unsigned int> > pairs(new vector<unsigned int>());
 
    LogVerbatim("HLTDoubletDZ") << " XXX " << label_ << " 0 " << std::endl;
 
@@ -89,66 +114,140 @@ HLTDoubletDZ<T1,T2>::hltFilter(edm::Event& iEvent, const edm::EventSetup& iSetup
      const size_type n2(coll2_.size());
 
      if (saveTags()) {
-       InputTag tagOld;
        filterproduct.addCollectionTag(originTag1_);
        LogVerbatim("HLTDoubletDZ") << " XXX " << label_ << " 1a " << originTag1_.encode() << std::endl;
-       tagOld=InputTag();
-       for (size_type i1=0; i1!=n1; ++i1) {
-	 const ProductID pid(coll1_[i1].id());
-	 const string&    label(iEvent.getProvenance(pid).moduleLabel());
-	 const string& instance(iEvent.getProvenance(pid).productInstanceName());
-	 const string&  process(iEvent.getProvenance(pid).processName());
-	 InputTag tagNew(InputTag(label,instance,process));
-	 if (tagOld.encode()!=tagNew.encode()) {
-	   filterproduct.addCollectionTag(tagNew);
-	   tagOld=tagNew;
-           LogVerbatim("HLTDoubletDZ") << " XXX " << label_ << " 1b " << tagNew.encode() << std::endl;
-	 }
+       collectionTags_.tags(iEvent,coll1_,tags_);
+       for (unsigned int i=0; i!=tags_.size(); ++i) {
+	 filterproduct.addCollectionTag(tags_[i]);
+	 LogVerbatim("HLTDoubletDZ") << " XXX " << label_ << " 1b " << tags_[i].encode() << std::endl;
        }
        filterproduct.addCollectionTag(originTag2_);
        LogVerbatim("HLTDoubletDZ") << " XXX " << label_ << " 2a " << originTag2_.encode() << std::endl;
-       tagOld=InputTag();
-       for (size_type i2=0; i2!=n2; ++i2) {
-	 const ProductID pid(coll2_[i2].id());
-	 const string&    label(iEvent.getProvenance(pid).moduleLabel());
-	 const string& instance(iEvent.getProvenance(pid).productInstanceName());
-	 const string&  process(iEvent.getProvenance(pid).processName());
-	 InputTag tagNew(InputTag(label,instance,process));
-	 if (tagOld.encode()!=tagNew.encode()) {
-	   filterproduct.addCollectionTag(tagNew);
-	   tagOld=tagNew;
-           LogVerbatim("HLTDoubletDZ") << " XXX " << label_ << " 2b " << tagNew.encode() << std::endl;
-	 }
+       collectionTags_.tags(iEvent,coll2_,tags_);
+       for (unsigned int i=0; i!=tags_.size(); ++i) {
+	 filterproduct.addCollectionTag(tags_[i]);
+	 LogVerbatim("HLTDoubletDZ") << " XXX " << label_ << " 2b " << tags_[i].encode() << std::endl;
        }
      }
 
+     // resolve the Refs once, into contiguous arrays of the variables needed by the cuts
+     columns1_.fill(coll1_,groups_);
+     columns2_.fill(coll2_,groups_);
+
+     // sort the 2nd objects by vz, to consider only those within the DZ window of each 1st object;
+     // the window is slightly enlarged, so that rounding can not exclude any pair passing the actual cut
+     const double margin(1.e-6);
+     vz2_.clear();
+     undefined2_.clear();
+     for (unsigned int i2=0; i2!=n2; i2++) {
+       const double vz(columns2_.vz[i2]);
+       if (vz==vz) vz2_.push_back(make_pair(vz,i2));
+       else undefined2_.push_back(i2);   // an undefined vz passes the DZ cut with any other object
+     }
+     sort(vz2_.begin(),vz2_.end());
+
+     if (uniqueObjects_) {
+       saved1_.assign(n1,false);
+       saved2_.assign(n2,false);
+     }
+
      int n(0);
-     T1Ref r1;
-     T2Ref r2;
-     Particle::LorentzVector p1,p2,p;
-     for (unsigned int i1=0; i1!=n1; i1++) {
-       r1=coll1_[i1];
-       const reco::Candidate& candidate1(*r1);
+     unsigned int block2[kBlock];    // indices of a block of 2nd objects
+     unsigned char pass[kBlock];     // pairs passing the cuts, for a block of 2nd objects
+     // if the objects are not used downstream, stop as soon as enough pairs pass the cuts
+     for (unsigned int i1=0; (i1!=n1) && !(decisionOnly_ && n>=min_N_); i1++) {
+       const T1Ref & r1(coll1_[i1]);
        unsigned int I(0);
        if (same_) {I=i1+1;}
-       for (unsigned int i2=I; i2!=n2; i2++) {
-	 r2=coll2_[i2];
-	 if (checkSC_) {
-	   if (r1->superCluster().isNonnull() && r2->superCluster().isNonnull()) {
-	     if (r1->superCluster() == r2->superCluster()) continue;
+
+       // the 2nd objects to be considered, in increasing order
+       unsigned int m(I<n2 ? n2-I : 0);
+       const double vz1(columns1_.vz[i1]);
+       const bool window(vz1==vz1 && maxDZ_==maxDZ_);
+       if (window) {
+	 vector<pair<double,unsigned int> >::iterator lower(lower_bound(vz2_.begin(),vz2_.end(),make_pair(vz1-maxDZ_-margin,0u)));
+	 vector<pair<double,unsigned int> >::iterator upper(upper_bound(lower,vz2_.end(),make_pair(vz1+maxDZ_+margin,numeric_limits<unsigned int>::max())));
+	 window2_.clear();
+	 for (; lower!=upper; ++lower)
+	   if (lower->second>=I) window2_.push_back(lower->second);
+	 for (unsigned int i=0; i!=undefined2_.size(); ++i)
+	   if (undefined2_[i]>=I) window2_.push_back(undefined2_[i]);
+	 sort(window2_.begin(),window2_.end());
+	 m=window2_.size();
+       }
+
+       // check the cuts on a block of pairs at a time, then record the passing ones
+       for (unsigned int k=0; (k<m) && !(decisionOnly_ && n>=min_N_); k+=kBlock) {
+	 const unsigned int size(m-k<kBlock ? m-k : kBlock);
+	 for (unsigned int j=0; j!=size; ++j)
+	   block2[j] = window ? window2_[k+j] : I+k+j;
+	 selectPairs(i1,block2,size,pass);
+	 for (unsigned int j=0; j!=size; ++j) {
+	   if (not pass[j]) continue;
+	   const T2Ref & r2(coll2_[block2[j]]);
+	   if (checkSC_) {
+	     if (r1->superCluster().isNonnull() && r2->superCluster().isNonnull()) {
+	       if (r1->superCluster() == r2->superCluster()) continue;
+	     }
 	   }
+	   n++;
+	   if (not decisionOnly_) addPair(i1,block2[j],filterproduct,*pairs);
 	 }
- 	 const reco::Candidate& candidate2(*r2);
-	 if ( reco::deltaR(candidate1, candidate2) < minDR_ ) continue;
-	 if ( std::abs(candidate1.vz()-candidate2.vz()) > maxDZ_ ) continue;
-	 n++;
-	 filterproduct.addObject(triggerType1_,r1);
-	 filterproduct.addObject(triggerType2_,r2);
        }
      }
      // filter decision
      accept = accept || (n>=min_N_);
    }
 
+   if (savePairs_) iEvent.put(pairs);
+
    return accept;
 }
+
+// ------------ check the cuts on the pairs of the 1st object i1 with a block of 2nd objects ------------
+template<typename T1, typename T2>
+void
+HLTDoubletDZ<T1,T2>::selectPairs(unsigned int i1, const unsigned int * i2, unsigned int size, unsigned char * pass) const
+{
+   // the cuts are checked on the whole block, in loops without branches
+   const HLTObjectColumns & c1(columns1_);
+   const HLTObjectColumns & c2(columns2_);
+
+   for (unsigned int j=0; j!=size; ++j)
+     pass[j] = not (std::abs(c1.vz[i1]-c2.vz[i2[j]]) > maxDZ_);
+
+   // a DeltaR below a non-positive minimum is not possible, otherwise it is compared squared
+   if (minDR_ > 0.) {
+     for (unsigned int j=0; j!=size; ++j) {
+       const double deta(c1.eta[i1]-c2.eta[i2[j]]);
+       const double adphi(std::abs(c1.phi[i1]-c2.phi[i2[j]]));
+       const double dphi((adphi>M_PI) ? 2.0*M_PI-adphi : adphi);
+       pass[j] &= not (deta*deta+dphi*dphi < minDR2_);
+     }
+   }
+}
+
+// ------------ record the objects of a passing pair ------------
+template<typename T1, typename T2>
+void
+HLTDoubletDZ<T1,T2>::addPair(unsigned int i1, unsigned int i2, trigger::TriggerFilterObjectWithRefs & filterproduct, std::vector<unsigned int> & pairs)
+{
+   if (not uniqueObjects_) {
+     filterproduct.addObject(triggerType1_,coll1_[i1]);
+     filterproduct.addObject(triggerType2_,coll2_[i2]);
+   } else {
+     // each object is recorded only the first time it is part of a passing pair
+     if (not saved1_[i1]) {
+       filterproduct.addObject(triggerType1_,coll1_[i1]);
+       saved1_[i1] = true;
+     }
+     if (not saved2_[i2]) {
+       filterproduct.addObject(triggerType2_,coll2_[i2]);
+       saved2_[i2] = true;
+     }
+   }
+   if (savePairs_) {
+     pairs.push_back(i1);
+     pairs.push_back(i2);
+   }
+}
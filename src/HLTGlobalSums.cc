@@ -32,6 +32,7 @@ HLTGlobalSums<T>::HLTGlobalSums(const edm::ParameterSet& iConfig) : HLTFilter(iC
   min_        (iConfig.template getParameter<double>("Min")),
   max_        (iConfig.template getParameter<double>("Max")),
   min_N_      (iConfig.template getParameter<int>("MinN")),
+  decisionOnly_(iConfig.template getParameter<bool>("decisionOnly")),
   tid_(triggerType_)
 {
    LogDebug("") << "InputTags and cuts : " 
@@ -80,6 +81,7 @@ HLTGlobalSums<T>::fillDescriptions(edm::ConfigurationDescriptions& descriptions)
   desc.add<double>("Min",-1e125);
   desc.add<double>("Max",+1e125);
   desc.add<int>("MinN",1);
+  desc.add<bool>("decisionOnly",false);
   descriptions.add(std::string("hlt")+std::string(typeid(HLTGlobalSums<T>).name()),desc);
 }
 
@@ -132,6 +134,9 @@ HLTGlobalSums<T>::hltFilter(edm::Event& iEvent, const edm::EventSetup& iSetup, t
    typename TCollection::const_iterator iter;
    for (iter=ibegin; iter!=iend; iter++) {
 
+     // if the objects are not used downstream, stop as soon as enough objects pass the cuts
+     if (decisionOnly_ && (n>=min_N_)) break;
+
      // get hold of value of observable to cut on
      if ( (tid_==TriggerTET) || (tid_==TriggerTHT) ) {
        value=iter->sumEt();
@@ -148,6 +153,7 @@ HLTGlobalSums<T>::hltFilter(edm::Event& iEvent, const edm::EventSetup& iSetup, t
      if ( ( (min_<0.0) || (min_<=value) ) &&
 	  ( (max_<0.0) || (value<=max_) ) ) {
        n++;
+       if (decisionOnly_) continue;
        ref=TRef(objects,distance(ibegin,iter));
        filterproduct.addObject(tid_,ref);
      }
@@ -7,6 +7,8 @@
  *    - look at different bunch crossings
  *    - use or ignore the L1 trigger mask
  *    - only look at a subset of the L1 bits
+ *  The number of L1 bits is taken from the L1 mask and from the L1 results,
+ *  so L1 menus with more than 128 physics bits are supported
  * 
  *  $Date: 2012/01/22 23:31:49 $
  *  $Revision: 1.14 $
@@ -16,6 +18,7 @@
  */
 
 #include <vector>
+#include <algorithm>
 
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "FWCore/Framework/interface/Event.h"
@@ -28,10 +31,6 @@
 #include "CondFormats/DataRecord/interface/L1GtTriggerMaskTechTrigRcd.h"
 #include "CondFormats/DataRecord/interface/L1GtTriggerMaskAlgoTrigRcd.h"
 
-// FIXME: these should come form the L1 configuration at runtime
-#define PHYSICS_BITS_SIZE    128
-#define TECHNICAL_BITS_SIZE   64
-
 //
 // class declaration
 //
@@ -44,15 +43,26 @@ public:
   virtual bool filter(edm::Event&, const edm::EventSetup&);
 
 private:
-  edm::InputTag     m_gtReadoutRecord;
-  std::vector<int>  m_bunchCrossings;
-  std::vector<bool> m_selectPhysics;
-  std::vector<bool> m_selectTechnical;
-  std::vector<bool> m_maskedPhysics;
-  std::vector<bool> m_maskedTechnical;
-  unsigned int      m_daqPartitions;
-  bool              m_ignoreL1Mask;
-  bool              m_invert;
+  typedef std::vector<unsigned long long> Words;
+
+  /// pack 64 consecutive bits, starting from bit 64*word, into a single word
+  static unsigned long long pack(const std::vector<bool> & bits, unsigned int word);
+
+  /// check if any of the selected bits is set in the L1 decision word
+  static bool match(const Words & selected, const std::vector<bool> & bits);
+
+  /// remove the bits masked in the L1 configuration from the selection; the L1 mask also defines the number of bits
+  void applyMask(const Words & select, const std::vector<unsigned int> & mask, Words & masked) const;
+
+  edm::InputTag      m_gtReadoutRecord;
+  std::vector<int>   m_bunchCrossings;
+  Words              m_selectPhysics;
+  Words              m_selectTechnical;
+  Words              m_maskedPhysics;
+  Words              m_maskedTechnical;
+  unsigned int       m_daqPartitions;
+  bool               m_ignoreL1Mask;
+  bool               m_invert;
 
   edm::ESWatcher<L1GtTriggerMaskAlgoTrigRcd> m_watchPhysicsMask;
   edm::ESWatcher<L1GtTriggerMaskTechTrigRcd> m_watchTechnicalMask;
@@ -72,35 +82,68 @@ private:
 HLTLevel1Activity::HLTLevel1Activity(const edm::ParameterSet & config) :
   m_gtReadoutRecord( config.getParameter<edm::InputTag>     ("L1GtReadoutRecordTag") ),
   m_bunchCrossings(  config.getParameter<std::vector<int> > ("bunchCrossings") ),
-  m_selectPhysics(   PHYSICS_BITS_SIZE ),
-  m_selectTechnical( TECHNICAL_BITS_SIZE ),
-  m_maskedPhysics(   PHYSICS_BITS_SIZE ),
-  m_maskedTechnical( TECHNICAL_BITS_SIZE ),
+  m_selectPhysics(   config.getParameter<Words>             ("physicsExtraBits") ),
+  m_selectTechnical( 1, config.getParameter<unsigned long long>("technicalBits") ),
+  m_maskedPhysics(),
+  m_maskedTechnical(),
   m_daqPartitions(   config.getParameter<unsigned int>      ("daqPartitions") ),
   m_ignoreL1Mask(    config.getParameter<bool>              ("ignoreL1Mask") ),
   m_invert(          config.getParameter<bool>              ("invert") )
 {
-  unsigned long long low  = config.getParameter<unsigned long long>("physicsLoBits");
-  unsigned long long high = config.getParameter<unsigned long long>("physicsHiBits");
-  unsigned long long tech = config.getParameter<unsigned long long>("technicalBits");
-  for (unsigned int i = 0; i < 64; i++) {
-    m_selectPhysics[i]    = low  & (0x01ULL << (unsigned long long) i);
-    m_maskedPhysics[i]    = low  & (0x01ULL << (unsigned long long) i);
-  }
-  for (unsigned int i = 0; i < 64; i++) {
-    m_selectPhysics[i+64] = high & (0x01ULL << (unsigned long long) i);
-    m_maskedPhysics[i+64] = high & (0x01ULL << (unsigned long long) i);
-  }
-  for (unsigned int i = 0; i < 64; i++) {
-    m_selectTechnical[i]  = tech & (0x01ULL << (unsigned long long) i);
-    m_maskedTechnical[i]  = tech & (0x01ULL << (unsigned long long) i);
-  }
+  // the first 128 physics bits are given by physicsLoBits and physicsHiBits, the others (if any) by physicsExtraBits
+  m_selectPhysics.insert(m_selectPhysics.begin(), config.getParameter<unsigned long long>("physicsHiBits"));
+  m_selectPhysics.insert(m_selectPhysics.begin(), config.getParameter<unsigned long long>("physicsLoBits"));
+
+  // until the L1 mask is read, or if it is ignored, all the selected bits are used
+  m_maskedPhysics   = m_selectPhysics;
+  m_maskedTechnical = m_selectTechnical;
 }
 
 HLTLevel1Activity::~HLTLevel1Activity()
 {
 }
 
+unsigned long long
+HLTLevel1Activity::pack(const std::vector<bool> & bits, unsigned int word)
+{
+  const unsigned int first = word * 64;
+  const unsigned int size  = std::min((unsigned int) bits.size() - first, 64u);
+  unsigned long long packed = 0;
+  for (unsigned int i = 0; i < size; ++i)
+    packed |= (unsigned long long) bits[first + i] << i;
+  return packed;
+}
+
+bool
+HLTLevel1Activity::match(const Words & selected, const std::vector<bool> & bits)
+{
+  // the bits not present in the L1 decision word are considered as not fired
+  const unsigned int words = std::min((unsigned int) selected.size(), (unsigned int) (bits.size() + 63) / 64);
+  for (unsigned int w = 0; w < words; ++w)
+    if (selected[w] and (selected[w] & pack(bits, w)))
+      return true;
+  return false;
+}
+
+void
+HLTLevel1Activity::applyMask(const Words & select, const std::vector<unsigned int> & mask, Words & masked) const
+{
+  //  - mask & partition == part. --> fully masked
+  //  - mask & partition == 0x00  --> fully unmasked
+  //  - mask & partition != part. --> unmasked in some partitions, consider as unmasked
+  // bits beyond the size of the L1 mask do not exist in the L1 menu, and are dropped
+  const unsigned int words = std::min((unsigned int) select.size(), (unsigned int) (mask.size() + 63) / 64);
+  masked.assign(words, 0);
+  for (unsigned int w = 0; w < words; ++w) {
+    if (not select[w])
+      continue;
+    const unsigned int size = std::min((unsigned int) mask.size() - w * 64, 64u);
+    for (unsigned int i = 0; i < size; ++i)
+      if ((mask[w * 64 + i] & m_daqPartitions) != m_daqPartitions)
+        masked[w] |= select[w] & (0x01ULL << i);
+  }
+}
+
 void
 HLTLevel1Activity::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
   edm::ParameterSetDescription desc;
@@ -119,6 +162,7 @@ HLTLevel1Activity::fillDescriptions(edm::ConfigurationDescriptions& descriptions
   desc.add<unsigned long long int>("physicsLoBits",1);
   desc.add<unsigned long long int>("physicsHiBits",262144);
   desc.add<unsigned long long int>("technicalBits",1);
+  desc.add<std::vector<unsigned long long int> >("physicsExtraBits",std::vector<unsigned long long int>());
   descriptions.add("hltLevel1Activity",desc);
 }
 
@@ -131,49 +175,38 @@ bool
 HLTLevel1Activity::filter(edm::Event& event, const edm::EventSetup& setup)
 {
   // apply L1 mask to the physics bits
-  //  - mask & partition == part. --> fully masked
-  //  - mask & partition == 0x00  --> fully unmasked
-  //  - mask & partition != part. --> unmasked in some partitions, consider as unmasked
   if (not m_ignoreL1Mask and m_watchPhysicsMask.check(setup)) {
     edm::ESHandle<L1GtTriggerMask> h_mask;
     setup.get<L1GtTriggerMaskAlgoTrigRcd>().get(h_mask);
-    const std::vector<unsigned int> & mask = h_mask->gtTriggerMask();
-    for (unsigned int i = 0; i < PHYSICS_BITS_SIZE; ++i)
-      m_maskedPhysics[i] = m_selectPhysics[i] and ((mask[i] & m_daqPartitions) != m_daqPartitions);
+    applyMask(m_selectPhysics, h_mask->gtTriggerMask(), m_maskedPhysics);
   }
   
   // apply L1 mask to the technical bits
-  //  - mask & partition == part. --> fully masked
-  //  - mask & partition == 0x00  --> fully unmasked
-  //  - mask & partition != part. --> unmasked in some partitions, consider as unmasked
   if (not m_ignoreL1Mask and m_watchTechnicalMask.check(setup)) {
     edm::ESHandle<L1GtTriggerMask> h_mask;
     setup.get<L1GtTriggerMaskTechTrigRcd>().get(h_mask);
-    const std::vector<unsigned int> & mask = h_mask->gtTriggerMask();
-    for (unsigned int i = 0; i < TECHNICAL_BITS_SIZE; ++i)
-      m_maskedTechnical[i] = m_selectTechnical[i] and ((mask[i] & m_daqPartitions) != m_daqPartitions);
+    applyMask(m_selectTechnical, h_mask->gtTriggerMask(), m_maskedTechnical);
   }
 
   // access the L1 decisions
   edm::Handle<L1GlobalTriggerReadoutRecord> h_gtReadoutRecord;
   event.getByLabel(m_gtReadoutRecord, h_gtReadoutRecord);
 
-  // compare the results with the requested bits, and return true as soon as the first match is found
+  // compare the results with the requested bits, and return true as soon as the first match is found;
+  // the L1 decisions are packed into words only where any bit is requested, and compared a word at a time
   BOOST_FOREACH(int bx, m_bunchCrossings) {
     const std::vector<bool> & physics = h_gtReadoutRecord->decisionWord(bx);
-    if (physics.size() != PHYSICS_BITS_SIZE)
+    if (physics.empty())
       // error in L1 results
       return m_invert;
-    for (unsigned int i = 0; i < PHYSICS_BITS_SIZE; ++i)
-      if (m_maskedPhysics[i] and physics[i])
-        return not m_invert;
+    if (match(m_maskedPhysics, physics))
+      return not m_invert;
     const std::vector<bool> & technical = h_gtReadoutRecord->technicalTriggerWord(bx);
-    if (technical.size() != TECHNICAL_BITS_SIZE)
+    if (technical.empty())
       // error in L1 results
       return m_invert;
-    for (unsigned int i = 0; i < TECHNICAL_BITS_SIZE; ++i)
-      if (m_maskedTechnical[i] and technical[i])
-        return not m_invert;
+    if (match(m_maskedTechnical, technical))
+      return not m_invert;
   }
  
   return m_invert; 
@@ -0,0 +1,326 @@
+/** \class HLTLevel1MultiPattern
+ *
+ *
+ *  This class is an EDFilter
+ *  that checks for specific patterns of L1 accept/reject in several BX's for a list of L1 bits,
+ *  as the HLTLevel1Pattern does for a single L1 bit.
+ *  The L1 results for each BX are read and packed only once, and shared by all the patterns.
+ *  It can be configured to
+ *    - use or ignore the L1 trigger mask
+ *    - accept the event if any (OR) or all (AND) of the patterns match
+ *  The result of each pattern is also stored in the Event as a std::vector<bool>, with
+ *  the names of the L1 bits stored in the Run, so that each of them can be used by
+ *  a TriggerBitFilter.
+ *
+ *  \author Andrea Bocci
+ *
+ */
+
+#include <vector>
+#include <string>
+#include <set>
+
+#include "FWCore/Framework/interface/ESWatcher.h"
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/Run.h"
+#include "FWCore/Framework/interface/EDFilter.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "CondFormats/DataRecord/interface/L1GtTriggerMenuRcd.h"
+#include "CondFormats/DataRecord/interface/L1GtTriggerMaskTechTrigRcd.h"
+#include "CondFormats/DataRecord/interface/L1GtTriggerMaskAlgoTrigRcd.h"
+
+//
+// class declaration
+//
+
+class HLTLevel1MultiPattern : public edm::EDFilter {
+public:
+  explicit HLTLevel1MultiPattern(const edm::ParameterSet&);
+  ~HLTLevel1MultiPattern();
+  static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
+  virtual bool beginRun(edm::Run&, const edm::EventSetup&);
+  virtual bool filter(edm::Event&, const edm::EventSetup&);
+
+private:
+  typedef std::vector<unsigned long long> Words;
+
+  // a single L1 bit, and the pattern it should match
+  struct Pattern {
+    std::string       triggerBit;
+    std::vector<bool> triggerPattern;
+    unsigned int      triggerNumber;
+    bool              triggerAlgo;
+    bool              triggerValid;
+    bool              triggerMasked;
+  };
+
+  /// pack the L1 decision word into 64-bit words
+  static void pack(const std::vector<bool> & bits, Words & words);
+
+  /// check if the given L1 bit is masked
+  bool isMasked(const std::vector<unsigned int> & mask, unsigned int bit) const;
+
+  /// check if the packed L1 results match the pattern
+  bool match(const Pattern & pattern) const;
+
+  edm::InputTag        m_gtReadoutRecord;
+  std::vector<int>     m_bunchCrossings;
+  std::vector<Pattern> m_patterns;
+  unsigned int         m_daqPartitions;
+  bool                 m_andOr;
+  bool                 m_ignoreL1Mask;
+  bool                 m_invert;
+  bool                 m_throw;
+
+  // L1 results packed for each BX, and their sizes
+  std::vector<Words>        m_physics;
+  std::vector<Words>        m_technical;
+  std::vector<unsigned int> m_physicsSize;
+  std::vector<unsigned int> m_technicalSize;
+
+  edm::ESWatcher<L1GtTriggerMenuRcd>         m_watchL1Menu;
+  edm::ESWatcher<L1GtTriggerMaskAlgoTrigRcd> m_watchPhysicsMask;
+  edm::ESWatcher<L1GtTriggerMaskTechTrigRcd> m_watchTechnicalMask;
+};
+
+#include <memory>
+#include <boost/foreach.hpp>
+
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "CondFormats/L1TObjects/interface/L1GtTriggerMenu.h"
+#include "CondFormats/L1TObjects/interface/L1GtTriggerMask.h"
+#include "DataFormats/L1GlobalTrigger/interface/L1GlobalTriggerReadoutRecord.h"
+
+//
+// constructors and destructor
+//
+HLTLevel1MultiPattern::HLTLevel1MultiPattern(const edm::ParameterSet & config) :
+  m_gtReadoutRecord( config.getParameter<edm::InputTag>     ("L1GtReadoutRecordTag") ),
+  m_bunchCrossings(  config.getParameter<std::vector<int> > ("bunchCrossings") ),
+  m_patterns(),
+  m_daqPartitions(   config.getParameter<unsigned int>      ("daqPartitions") ),
+  m_andOr(           config.getParameter<bool>              ("andOr") ),
+  m_ignoreL1Mask(    config.getParameter<bool>              ("ignoreL1Mask") ),
+  m_invert(          config.getParameter<bool>              ("invert") ),
+  m_throw (          config.getParameter<bool>              ("throw" ) ),
+  m_physics(         m_bunchCrossings.size() ),
+  m_technical(       m_bunchCrossings.size() ),
+  m_physicsSize(     m_bunchCrossings.size(), 0 ),
+  m_technicalSize(   m_bunchCrossings.size(), 0 )
+{
+  const std::vector<edm::ParameterSet> & patterns = config.getParameter<std::vector<edm::ParameterSet> >("triggerPatterns");
+  m_patterns.resize(patterns.size());
+  std::set<std::string> triggerBits;
+  for (unsigned int p = 0; p < patterns.size(); ++p) {
+    Pattern & pattern = m_patterns[p];
+    pattern.triggerBit    = patterns[p].getParameter<std::string>("triggerBit");
+    // the L1 bit names are stored in the Run to look up the individual results, so each can only be used once
+    if (not triggerBits.insert(pattern.triggerBit).second)
+      throw cms::Exception("Configuration") << "L1 trigger \"" << pattern.triggerBit << "\" is used by more than one pattern";
+    pattern.triggerNumber = 0;
+    pattern.triggerAlgo   = true;
+    pattern.triggerValid  = false;
+    pattern.triggerMasked = false;
+
+    std::vector<int> values( patterns[p].getParameter<std::vector<int> > ("triggerPattern") );
+    if (values.size() != m_bunchCrossings.size())
+      throw cms::Exception("Configuration") << "\"bunchCrossings\" and \"triggerPattern\" parameters do not match for L1 trigger \"" << pattern.triggerBit << "\"";
+    pattern.triggerPattern.resize(values.size());
+    for (unsigned int i = 0; i < values.size(); ++i)
+      pattern.triggerPattern[i] = (bool) values[i];
+  }
+
+  produces<std::vector<bool> >();
+  produces<std::vector<std::string>, edm::InRun>();
+}
+
+HLTLevel1MultiPattern::~HLTLevel1MultiPattern()
+{
+}
+
+void
+HLTLevel1MultiPattern::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("L1GtReadoutRecordTag",edm::InputTag("hltGtDigis"));
+  {
+    std::vector<int> temp1;
+    temp1.reserve(5);
+    temp1.push_back(-2);
+    temp1.push_back(-1);
+    temp1.push_back(0);
+    temp1.push_back(1);
+    temp1.push_back(2);
+    desc.add<std::vector<int> >("bunchCrossings",temp1);
+  }
+  desc.add<unsigned int>("daqPartitions",1);
+  desc.add<bool>("andOr",true);
+  desc.add<bool>("ignoreL1Mask",false);
+  desc.add<bool>("invert",false);
+  desc.add<bool>("throw",true);
+  {
+    edm::ParameterSetDescription pattern;
+    pattern.add<std::string>("triggerBit","L1Tech_RPC_TTU_pointing_Cosmics.v0");
+    std::vector<int> temp1;
+    temp1.reserve(5);
+    temp1.push_back(1);
+    temp1.push_back(1);
+    temp1.push_back(1);
+    temp1.push_back(0);
+    temp1.push_back(0);
+    pattern.add<std::vector<int> >("triggerPattern",temp1);
+
+    edm::ParameterSet temp2;
+    temp2.addParameter<std::string>("triggerBit","L1Tech_RPC_TTU_pointing_Cosmics.v0");
+    temp2.addParameter<std::vector<int> >("triggerPattern",temp1);
+    desc.addVPSet("triggerPatterns",pattern,std::vector<edm::ParameterSet>(1,temp2));
+  }
+  descriptions.add("hltLevel1MultiPattern",desc);
+}
+
+//
+// member functions
+//
+
+void
+HLTLevel1MultiPattern::pack(const std::vector<bool> & bits, Words & words)
+{
+  const unsigned int size = bits.size();
+  words.assign((size + 63) / 64, 0);
+  for (unsigned int i = 0; i < size; ++i)
+    words[i / 64] |= (unsigned long long) bits[i] << (i % 64);
+}
+
+bool
+HLTLevel1MultiPattern::isMasked(const std::vector<unsigned int> & mask, unsigned int bit) const
+{
+  //  - mask & partition == part. --> fully masked
+  //  - mask & partition == 0x00  --> fully unmasked
+  //  - mask & partition != part. --> unmasked in some partitions, consider as unmasked
+  // a bit beyond the size of the L1 mask is not masked
+  return (bit < mask.size()) and ((mask[bit] & m_daqPartitions) == m_daqPartitions);
+}
+
+bool
+HLTLevel1MultiPattern::match(const Pattern & pattern) const
+{
+  if (not pattern.triggerValid)
+    return false;
+
+  if (not m_ignoreL1Mask and pattern.triggerMasked)
+    return false;
+
+  const unsigned int word = pattern.triggerNumber / 64;
+  const unsigned int bit  = pattern.triggerNumber % 64;
+  for (unsigned int i = 0; i < m_bunchCrossings.size(); ++i) {
+    const Words & words = (pattern.triggerAlgo) ? m_physics[i]     : m_technical[i];
+    const unsigned int size = (pattern.triggerAlgo) ? m_physicsSize[i] : m_technicalSize[i];
+    if (pattern.triggerNumber >= size)
+      // L1 results not available
+      return false;
+    bool result = (words[word] >> bit) & 0x01ULL;
+    if (result != pattern.triggerPattern[i])
+      // comparison failed
+      return false;
+  }
+
+  // comparison successful
+  return true;
+}
+
+bool
+HLTLevel1MultiPattern::beginRun(edm::Run & run, const edm::EventSetup & setup)
+{
+  // store the names of the L1 bits, so the individual results can be looked up by name
+  std::auto_ptr<std::vector<std::string> > names( new std::vector<std::string>() );
+  names->reserve(m_patterns.size());
+  BOOST_FOREACH(const Pattern & pattern, m_patterns)
+    names->push_back(pattern.triggerBit);
+  run.put(names);
+  return true;
+}
+
+// ------------ method called to produce the data  ------------
+bool
+HLTLevel1MultiPattern::filter(edm::Event& event, const edm::EventSetup& setup)
+{
+  // determine the L1 algo or tech bits to use
+  bool menuUpdated = m_watchL1Menu.check(setup);
+  if (menuUpdated) {
+    edm::ESHandle<L1GtTriggerMenu> h_menu;
+    setup.get<L1GtTriggerMenuRcd>().get(h_menu);
+
+    const AlgorithmMap & algoMap = h_menu->gtAlgorithmAliasMap();
+    const AlgorithmMap & techMap = h_menu->gtTechnicalTriggerMap();
+    BOOST_FOREACH(Pattern & pattern, m_patterns) {
+      AlgorithmMap::const_iterator entry;
+      pattern.triggerValid = true;
+      if ((entry = algoMap.find(pattern.triggerBit)) != algoMap.end()) {
+        pattern.triggerAlgo = true;
+        pattern.triggerNumber = entry->second.algoBitNumber();
+      } else
+      if ((entry = techMap.find(pattern.triggerBit)) != techMap.end()) {
+        pattern.triggerAlgo = false;
+        pattern.triggerNumber = entry->second.algoBitNumber();
+      } else {
+        if (m_throw)
+          throw cms::Exception("Configuration") << "requested L1 trigger \"" << pattern.triggerBit << "\" does not exist in the current L1 menu";
+        pattern.triggerValid = false;
+      }
+    }
+  }
+
+  // check the L1 algorithms and technical triggers masks, also if the L1 menu has changed
+  bool physicsMaskUpdated   = m_watchPhysicsMask.check(setup);
+  bool technicalMaskUpdated = m_watchTechnicalMask.check(setup);
+  if (menuUpdated or physicsMaskUpdated) {
+    edm::ESHandle<L1GtTriggerMask> h_mask;
+    setup.get<L1GtTriggerMaskAlgoTrigRcd>().get(h_mask);
+    BOOST_FOREACH(Pattern & pattern, m_patterns)
+      if (pattern.triggerAlgo)
+        pattern.triggerMasked = isMasked(h_mask->gtTriggerMask(), pattern.triggerNumber);
+  }
+  if (menuUpdated or technicalMaskUpdated) {
+    edm::ESHandle<L1GtTriggerMask> h_mask;
+    setup.get<L1GtTriggerMaskTechTrigRcd>().get(h_mask);
+    BOOST_FOREACH(Pattern & pattern, m_patterns)
+      if (not pattern.triggerAlgo)
+        pattern.triggerMasked = isMasked(h_mask->gtTriggerMask(), pattern.triggerNumber);
+  }
+
+  // access the L1 decisions, and pack them once for each BX
+  edm::Handle<L1GlobalTriggerReadoutRecord> h_gtReadoutRecord;
+  event.getByLabel(m_gtReadoutRecord, h_gtReadoutRecord);
+  for (unsigned int i = 0; i < m_bunchCrossings.size(); ++i) {
+    int bx = m_bunchCrossings[i];
+    const std::vector<bool> & physics   = h_gtReadoutRecord->decisionWord(bx);
+    const std::vector<bool> & technical = h_gtReadoutRecord->technicalTriggerWord(bx);
+    pack(physics,   m_physics[i]);
+    pack(technical, m_technical[i]);
+    m_physicsSize[i]   = physics.size();
+    m_technicalSize[i] = technical.size();
+  }
+
+  // compare all the patterns with the packed L1 results
+  std::auto_ptr<std::vector<bool> > results( new std::vector<bool>(m_patterns.size(), false) );
+  unsigned int matched = 0;
+  for (unsigned int p = 0; p < m_patterns.size(); ++p)
+    if (match(m_patterns[p])) {
+      (*results)[p] = true;
+      ++matched;
+    }
+  event.put(results);
+
+  const bool accept( (matched > 0) and (m_andOr or (matched == m_patterns.size())) );
+  return accept xor m_invert;
+}
+
+// define as a framework plugin
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE(HLTLevel1MultiPattern);
@@ -39,6 +39,9 @@ public:
   virtual bool filter(edm::Event&, const edm::EventSetup&);
 
 private:
+  /// check if the requested trigger is masked; the size of the L1 mask follows the L1 menu
+  bool isMasked(const std::vector<unsigned int> & mask) const;
+
   edm::InputTag     m_gtReadoutRecord;
   std::string       m_triggerBit;
   std::vector<int>  m_bunchCrossings;
@@ -93,6 +96,13 @@ HLTLevel1Pattern::~HLTLevel1Pattern()
 {
 }
 
+bool
+HLTLevel1Pattern::isMasked(const std::vector<unsigned int> & mask) const
+{
+  // a bit beyond the size of the L1 mask is not masked
+  return (m_triggerNumber < mask.size()) and ((mask[m_triggerNumber] & m_daqPartitions) == m_daqPartitions);
+}
+
 void
 HLTLevel1Pattern::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
   edm::ParameterSetDescription desc;
@@ -166,7 +176,7 @@ HLTLevel1Pattern::filter(edm::Event& event, const edm::EventSetup& setup)
     if (m_watchPhysicsMask.check(setup)) {
       edm::ESHandle<L1GtTriggerMask> h_mask;
       setup.get<L1GtTriggerMaskAlgoTrigRcd>().get(h_mask);
-      m_triggerMasked = ((h_mask->gtTriggerMask()[m_triggerNumber] & m_daqPartitions) == m_daqPartitions);
+      m_triggerMasked = isMasked(h_mask->gtTriggerMask());
     }
   } else {
     // check the L1 technical triggers mask
@@ -176,7 +186,7 @@ HLTLevel1Pattern::filter(edm::Event& event, const edm::EventSetup& setup)
     if (m_watchTechnicalMask.check(setup)) {
       edm::ESHandle<L1GtTriggerMask> h_mask;
       setup.get<L1GtTriggerMaskTechTrigRcd>().get(h_mask);
-      m_triggerMasked = ((h_mask->gtTriggerMask()[m_triggerNumber] & m_daqPartitions) == m_daqPartitions);
+      m_triggerMasked = isMasked(h_mask->gtTriggerMask());
     }
   }
 
@@ -0,0 +1,172 @@
+/** \class HLTMultiSinglet
+ *
+ * See header file for documentation
+ *
+ *  \author Martin Grunewald
+ *
+ */
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Framework/interface/Run.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/Common/interface/Ref.h"
+#include "DataFormats/HLTReco/interface/TriggerFilterObjectWithRefs.h"
+
+#include "HLTrigger/HLTfilters/interface/HLTMultiSinglet.h"
+
+#include <typeinfo>
+#include <memory>
+#include <set>
+
+//
+// constructors and destructor
+//
+template<typename T>
+HLTMultiSinglet<T>::HLTMultiSinglet(const edm::ParameterSet& iConfig) : HLTFilter(iConfig),
+  inputTag_    (iConfig.template getParameter<edm::InputTag>("inputTag")),
+  triggerType_ (iConfig.template getParameter<int>("triggerType")),
+  cuts_(),
+  active_(0),
+  columns_(),
+  pass_(),
+  any_()
+{
+   const std::vector<edm::ParameterSet> & cuts = iConfig.template getParameter<std::vector<edm::ParameterSet> >("cuts");
+   cuts_.reserve(cuts.size());
+   std::set<std::string> names;
+   for (unsigned int s=0; s!=cuts.size(); ++s) {
+     const std::string name     (cuts[s].template getParameter<std::string>("name"   ));
+     // each cut set is saved as a separate product instance, so its name must be a non-empty, unique label
+     if (name.empty())
+       throw cms::Exception("Configuration") << "cut set " << s << " has an empty \"name\"";
+     if (not names.insert(name).second)
+       throw cms::Exception("Configuration") << "cut set " << s << " has the duplicate \"name\" \"" << name << "\"";
+     const double      min_E    (cuts[s].template getParameter<double>     ("MinE"   ));
+     const double      min_Pt   (cuts[s].template getParameter<double>     ("MinPt"  ));
+     const double      min_Mass (cuts[s].template getParameter<double>     ("MinMass"));
+     const double      max_Eta  (cuts[s].template getParameter<double>     ("MaxEta" ));
+     const int         min_N    (cuts[s].template getParameter<int>        ("MinN"   ));
+     cuts_.push_back(Cuts(name, HLTKinematicCuts(min_E, min_Pt, min_Mass, max_Eta), min_N));
+     active_ |= cuts_.back().cuts.active();
+
+     LogDebug("") << "Input/name/ptcut/etacut/ncut : "
+		  << inputTag_.encode() << " " << name << " "
+		  << min_E << " " << min_Pt << " " << min_Mass << " "
+		  << max_Eta << " " << min_N ;
+
+     produces<trigger::TriggerFilterObjectWithRefs>(name);
+   }
+
+   produces<std::vector<bool> >();
+   produces<std::vector<std::string>, edm::InRun>();
+}
+
+template<typename T>
+HLTMultiSinglet<T>::~HLTMultiSinglet()
+{
+}
+
+template<typename T>
+void
+HLTMultiSinglet<T>::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  makeHLTFilterDescription(desc);
+  desc.add<edm::InputTag>("inputTag",edm::InputTag("hltCollection"));
+  desc.add<int>("triggerType",0);
+  {
+    edm::ParameterSetDescription cuts;
+    cuts.add<std::string>("name","");
+    cuts.add<double>("MinE",-1.0);
+    cuts.add<double>("MinPt",-1.0);
+    cuts.add<double>("MinMass",-1.0);
+    cuts.add<double>("MaxEta",-1.0);
+    cuts.add<int>("MinN",1);
+    desc.addVPSet("cuts",cuts,std::vector<edm::ParameterSet>());
+  }
+  descriptions.add(std::string("hlt")+std::string(typeid(HLTMultiSinglet<T>).name()),desc);
+}
+
+//
+// member functions
+//
+
+template<typename T>
+bool
+HLTMultiSinglet<T>::beginRun(edm::Run& iRun, const edm::EventSetup& iSetup)
+{
+   // store the names of the sets of cuts, so the individual decisions can be looked up by name
+   std::auto_ptr<std::vector<std::string> > names(new std::vector<std::string>());
+   names->reserve(cuts_.size());
+   for (unsigned int s=0; s!=cuts_.size(); ++s)
+     names->push_back(cuts_[s].name);
+   iRun.put(names);
+   return true;
+}
+
+// ------------ method called to produce the data  ------------
+template<typename T>
+bool
+HLTMultiSinglet<T>::hltFilter(edm::Event& iEvent, const edm::EventSetup& iSetup, trigger::TriggerFilterObjectWithRefs & filterproduct)
+{
+   using namespace std;
+   using namespace edm;
+   using namespace reco;
+   using namespace trigger;
+
+   typedef vector<T> TCollection;
+   typedef Ref<TCollection> TRef;
+
+   // All HLT filters must create and fill an HLT filter object,
+   // recording any reconstructed physics objects satisfying (or not)
+   // this HLT filter, and place it in the Event.
+
+   // The filter object
+   if (saveTags()) filterproduct.addCollectionTag(inputTag_);
+
+   // get hold of collection of objects
+   Handle<TCollection> objects;
+   iEvent.getByLabel (inputTag_,objects);
+
+   // gather the kinematic variables needed by any set of cuts into contiguous arrays, once for all sets
+   const unsigned int size(objects->size());
+   HLTKinematicCuts::gather(*objects, size, active_, columns_);
+   any_.assign(size,0);
+
+   auto_ptr<vector<bool> > decisions(new vector<bool>(cuts_.size(),false));
+   bool accept(false);
+   for (unsigned int s=0; s!=cuts_.size(); ++s) {
+     const Cuts & cuts(cuts_[s]);
+
+     // check this set of cuts on all objects at once
+     cuts.cuts.select(columns_, size, pass_);
+
+     // add the objects passing this set of cuts to its own filter object
+     auto_ptr<TriggerFilterObjectWithRefs> product(new TriggerFilterObjectWithRefs(path(),module()));
+     if (saveTags()) product->addCollectionTag(inputTag_);
+     int n(0);
+     for (unsigned int i=0; i!=size; ++i) {
+       if (pass_[i]) {
+         n++;
+         any_[i] = 1;
+         product->addObject(triggerType_,TRef(objects,i));
+       }
+     }
+     iEvent.put(product,cuts.name);
+
+     // filter decision for this set of cuts
+     (*decisions)[s] = (n>=cuts.min_N);
+     accept = accept || (*decisions)[s];
+   }
+   iEvent.put(decisions);
+
+   // the common filter object holds the objects passing any set of cuts
+   for (unsigned int i=0; i!=size; ++i) {
+     if (any_[i]) filterproduct.addObject(triggerType_,TRef(objects,i));
+   }
+
+   return accept;
+}
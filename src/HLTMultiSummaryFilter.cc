@@ -0,0 +1,123 @@
+/** \class HLTMultiSummaryFilter
+ *
+ * See header file for documentation
+ *
+ *  \author Martin Grunewald
+ *
+ */
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Framework/interface/Run.h"
+#include "HLTrigger/HLTfilters/interface/HLTMultiSummaryFilter.h"
+
+#include "DataFormats/Common/interface/Handle.h"
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include <memory>
+
+//
+// constructors and destructor
+//
+HLTMultiSummaryFilter::HLTMultiSummaryFilter(const edm::ParameterSet& iConfig) : HLTFilter(iConfig),
+  summaryTag_ (iConfig.getParameter<edm::InputTag>("summary")),
+  selections_ (),
+  columns_    (),
+  workspace_  (),
+  pass_       ()
+{
+  const std::vector<edm::ParameterSet> & selections = iConfig.getParameter<std::vector<edm::ParameterSet> >("selections");
+  selections_.reserve(selections.size());
+  for (unsigned int s=0; s!=selections.size(); ++s) {
+    const std::string   name   (selections[s].getParameter<std::string>  ("name"  ));
+    const edm::InputTag member (selections[s].getParameter<edm::InputTag>("member"));
+    const std::string   cut    (selections[s].getParameter<std::string>  ("cut"   ));
+    const int           min_N  (selections[s].getParameter<int>          ("minN"  ));
+    selections_.push_back(Selection(name, member, cut, min_N));
+
+    edm::LogInfo("HLTMultiSummaryFilter")
+       << "Summary/name/member/cut/ncut : "
+       << summaryTag_.encode() << " "
+       << name << " "
+       << member.encode() << " "
+       << cut << " " << min_N ;
+  }
+
+  produces<std::vector<bool> >();
+  produces<std::vector<std::string>, edm::InRun>();
+}
+
+HLTMultiSummaryFilter::~HLTMultiSummaryFilter()
+{
+}
+
+//
+// member functions
+//
+
+bool
+HLTMultiSummaryFilter::beginRun(edm::Run& iRun, const edm::EventSetup& iSetup)
+{
+   // store the names of the selections, so the individual decisions can be looked up by name
+   std::auto_ptr<std::vector<std::string> > names(new std::vector<std::string>());
+   names->reserve(selections_.size());
+   for (unsigned int s=0; s!=selections_.size(); ++s)
+     names->push_back(selections_[s].name);
+   iRun.put(names);
+   return true;
+}
+
+// ------------ method called to produce the data  ------------
+bool
+HLTMultiSummaryFilter::hltFilter(edm::Event& iEvent, const edm::EventSetup& iSetup, trigger::TriggerFilterObjectWithRefs & filterproduct)
+{
+   using namespace std;
+   using namespace edm;
+   using namespace reco;
+   using namespace trigger;
+
+   auto_ptr<vector<bool> > decisions(new vector<bool>(selections_.size(),false));
+
+   Handle<TriggerEvent> summary;
+   iEvent.getByLabel(summaryTag_,summary);
+
+   if (!summary.isValid()) {
+     LogError("HLTMultiSummaryFilter") << "Trigger summary product "
+				       << summaryTag_.encode()
+				       << " not found! Filter returns false always";
+     iEvent.put(decisions);
+     return false;
+   }
+
+   // columnar view of the trigger objects of this event, shared by all the selections
+   columns_.reset(summary->getObjects());
+
+   bool accept(false);
+   for (unsigned int s=0; s!=selections_.size(); ++s) {
+     Selection & selection(selections_[s]);
+
+     // a selection whose filter or collection is not in the summary fails
+     if (not selection.member.find(*summary)) {
+       LogInfo("HLTMultiSummaryFilter") << " " << selection.name << " default decision: " << false;
+       continue;
+     }
+
+     // check the cut on the passing physics objects of a filter, or on all physics objects of a full "L3" collection
+     selection.member.select(*summary,columns_,*selection.select,workspace_,pass_);
+     size_type n(0);
+     const size_type n1(pass_.size());
+     for (size_type i=0; i!=n1; ++i) {
+       if (pass_[i]) n++;
+     }
+     (*decisions)[s] = (n>=selection.min_N);
+     accept = accept || (*decisions)[s];
+     LogInfo("HLTMultiSummaryFilter")
+       << " " << selection.name << (selection.member.filter() ? " filter objects: " : " collection objects: ") << n << "/" << n1;
+   }
+
+   iEvent.put(decisions);
+   return accept;
+}
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE(HLTMultiSummaryFilter);
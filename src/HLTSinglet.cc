@@ -23,52 +23,65 @@
 
 #include <typeinfo>
 
-// extract the candidate type
+// extract the candidate type;
+// by default the configured triggerType is used for all objects, and this is known at compile time
 template<typename T>
-int getObjectType(const T &) {
-  return 0;
-}
+struct HLTSingletObjectType {
+  static const bool perObject = false;
+  static int type(const T &) {
+    return 0;
+  }
+};
 
 // specialize for type l1extra::L1EmParticle
-template<typename T>
-int getObjectType(const l1extra::L1EmParticle & candidate) {
-  switch (candidate.type()) {
-    case l1extra::L1EmParticle::kIsolated:
-      return trigger::TriggerL1IsoEG;
-    case l1extra::L1EmParticle::kNonIsolated:
-      return trigger::TriggerL1NoIsoEG;
-    default:
-      return 0;
+template<>
+struct HLTSingletObjectType<l1extra::L1EmParticle> {
+  static const bool perObject = true;
+  static int type(const l1extra::L1EmParticle & candidate) {
+    switch (candidate.type()) {
+      case l1extra::L1EmParticle::kIsolated:
+        return trigger::TriggerL1IsoEG;
+      case l1extra::L1EmParticle::kNonIsolated:
+        return trigger::TriggerL1NoIsoEG;
+      default:
+        return 0;
+    }
   }
-}
+};
 
 // specialize for type l1extra::L1EtMissParticle
-template<typename T>
-int getObjectType(const l1extra::L1EtMissParticle & candidate) {
-  switch (candidate.type()) {
-    case l1extra::L1EtMissParticle::kMET:
-      return trigger::TriggerL1ETM;
-    case l1extra::L1EtMissParticle::kMHT:
-      return trigger::TriggerL1HTM;
-    default:
-      return 0;
+template<>
+struct HLTSingletObjectType<l1extra::L1EtMissParticle> {
+  static const bool perObject = true;
+  static int type(const l1extra::L1EtMissParticle & candidate) {
+    switch (candidate.type()) {
+      case l1extra::L1EtMissParticle::kMET:
+        return trigger::TriggerL1ETM;
+      case l1extra::L1EtMissParticle::kMHT:
+        return trigger::TriggerL1HTM;
+      default:
+        return 0;
+    }
   }
-}
+};
 
 // specialize for type l1extra::L1JetParticle
-template<typename T>
-int getObjectType(const l1extra::L1JetParticle & candidate) {
-  switch (candidate.type()) {
-    case l1extra::L1JetParticle::kCentral:
-      return trigger::TriggerL1CenJet;
-    case l1extra::L1JetParticle::kForward:
-      return trigger::TriggerL1ForJet;
-    case l1extra::L1JetParticle::kTau:
-      return trigger::TriggerL1TauJet;
-    default:
-      return 0;
+template<>
+struct HLTSingletObjectType<l1extra::L1JetParticle> {
+  static const bool perObject = true;
+  static int type(const l1extra::L1JetParticle & candidate) {
+    switch (candidate.type()) {
+      case l1extra::L1JetParticle::kCentral:
+        return trigger::TriggerL1CenJet;
+      case l1extra::L1JetParticle::kForward:
+        return trigger::TriggerL1ForJet;
+      case l1extra::L1JetParticle::kTau:
+        return trigger::TriggerL1TauJet;
+      default:
+        return 0;
+    }
   }
-}
+};
 
 
 //
@@ -83,7 +96,11 @@ HLTSinglet<T>::HLTSinglet(const edm::ParameterSet& iConfig) : HLTFilter(iConfig)
   min_Mass_ (iConfig.template getParameter<double>       ("MinMass" )),
   max_Eta_  (iConfig.template getParameter<double>       ("MaxEta"  )),
   min_N_    (iConfig.template getParameter<int>          ("MinN"    )),
-  tid_ (triggerType_)
+  decisionOnly_ (iConfig.template getParameter<bool>     ("decisionOnly")),
+  assumePtSorted_ (iConfig.template getParameter<bool>   ("assumePtSorted")),
+  cuts_ (min_E_, min_Pt_, min_Mass_, max_Eta_),
+  columns_(),
+  pass_()
 {
    LogDebug("") << "Input/ptcut/etacut/ncut : "
 		<< inputTag_.encode() << " "
@@ -108,6 +125,8 @@ HLTSinglet<T>::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
   desc.add<double>("MinMass",-1.0);
   desc.add<double>("MaxEta",-1.0);
   desc.add<int>("MinN",1);
+  desc.add<bool>("decisionOnly",false);
+  desc.add<bool>("assumePtSorted",false);
   descriptions.add(std::string("hlt")+std::string(typeid(HLTSinglet<T>).name()),desc);
 }
 
@@ -115,6 +134,33 @@ HLTSinglet<T>::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
 // member functions
 //
 
+template<typename T>
+unsigned int
+HLTSinglet<T>::ptSortedSize(const std::vector<T> & objects) const
+{
+#ifdef EDM_ML_DEBUG
+   // check the ordering, as a wrong assumption would silently lose objects, and if it does not hold look at all the objects
+   for (unsigned int i=1; i<objects.size(); ++i) {
+     if (objects[i].pt() > objects[i-1].pt()) {
+       edm::LogWarning("HLTSingletNotPtSorted") << "Input collection " << inputTag_.encode() << " is not sorted by decreasing pt, while assumePtSorted is set";
+       return objects.size();
+     }
+   }
+#endif
+
+   // binary search for the first object below the pt threshold
+   unsigned int first(0);
+   unsigned int last(objects.size());
+   while (first<last) {
+     const unsigned int middle(first+(last-first)/2);
+     if (objects[middle].pt() >= min_Pt_)
+       first=middle+1;
+     else
+       last=middle;
+   }
+   return first;
+}
+
 // ------------ method called to produce the data  ------------
 template<typename T> 
 bool
@@ -143,19 +189,44 @@ HLTSinglet<T>::hltFilter(edm::Event& iEvent, const edm::EventSetup& iSetup, trig
    Handle<TCollection> objects;
    iEvent.getByLabel (inputTag_,objects);
 
-   // look at all objects, check cuts and add to filter object
+   // for a collection sorted by decreasing pt, only the leading objects above the pt threshold can pass the cuts
+   const unsigned int size( (assumePtSorted_ and (cuts_.active() & HLTKinematicCuts::kPt)) ? ptSortedSize(*objects) : objects->size() );
+
+   // if the objects are not used downstream, stop as soon as enough objects pass the cuts
+   if (decisionOnly_) {
+     int n(0);
+     for (unsigned int i=0; (n<min_N_) && (i!=size); ++i) {
+       if (cuts_((*objects)[i])) n++;
+     }
+     return (n>=min_N_);
+   }
+
+   // gather the kinematic variables needed by the active cuts into contiguous arrays,
+   // and check the cuts on all objects at once
+   HLTKinematicCuts::gather(*objects, size, cuts_.active(), columns_);
+   cuts_.select(columns_, size, pass_);
+
+   // add the objects passing the cuts to filter object
    int n(0);
-   typename TCollection::const_iterator i ( objects->begin() );
-   for (; i!=objects->end(); i++) {
-     if ( (i->energy() >= min_E_) &&
-	  (i->pt() >= min_Pt_) && 
-	  (i->mass() >= min_Mass_) && 
-	  ( (max_Eta_ < 0.0) || (std::abs(i->eta()) <= max_Eta_) ) ) {
-       n++;
-       ref=TRef(objects,distance(objects->begin(),i));
-       tid_=getObjectType<T>(*i);
-       if (tid_==0) tid_=triggerType_;
-       filterproduct.addObject(tid_,ref);
+   if (not HLTSingletObjectType<T>::perObject) {
+     // all objects have the configured triggerType
+     for (unsigned int i=0; i!=size; ++i) {
+       if (pass_[i]) {
+         n++;
+         ref=TRef(objects,i);
+         filterproduct.addObject(triggerType_,ref);
+       }
+     }
+   } else {
+     // look up the actual triggerType of each passing object, adding them in their original order
+     for (unsigned int i=0; i!=size; ++i) {
+       if (pass_[i]) {
+         n++;
+         int tid(HLTSingletObjectType<T>::type((*objects)[i]));
+         if (tid==0) tid=triggerType_;
+         ref=TRef(objects,i);
+         filterproduct.addObject(tid,ref);
+       }
      }
    }
 
@@ -30,13 +30,17 @@ HLTSmartSinglet<T>::HLTSmartSinglet(const edm::ParameterSet& iConfig) : HLTFilte
   triggerType_ (iConfig.template getParameter<int>("triggerType")),
   cut_      (iConfig.template getParameter<std::string>  ("cut"     )),
   min_N_    (iConfig.template getParameter<int>          ("MinN"    )),
-  select_   (cut_                                                    )
+  decisionOnly_ (iConfig.template getParameter<bool>     ("decisionOnly")),
+  select_   (HLTCutSelector<T>::get(cut_)                            ),
+  workspace_(),
+  pass_()
 {
   LogDebug("") << "Input/tyre/cut/ncut : "
 	       << inputTag_.encode() << " "
 	       << triggerType_ << " "
 	       << cut_<< " "
-	       << min_N_ ;
+	       << min_N_ << " "
+	       << (select_->compiled() ? "(compiled)" : "(interpreted)") ;
 }
 
 template<typename T>
@@ -53,6 +57,7 @@ HLTSmartSinglet<T>::fillDescriptions(edm::ConfigurationDescriptions& description
   desc.add<int>("triggerType",0);
   desc.add<std::string>("cut","1>0");
   desc.add<int>("MinN",1);
+  desc.add<bool>("decisionOnly",false);
   descriptions.add(std::string("hlt")+std::string(typeid(HLTSmartSinglet<T>).name()),desc);
 }
 
@@ -87,13 +92,24 @@ HLTSmartSinglet<T>::hltFilter(edm::Event& iEvent, const edm::EventSetup& iSetup,
    Handle<TCollection> objects;
    iEvent.getByLabel (inputTag_,objects);
 
-   // look at all objects, check cuts and add to filter object
+   // if the objects are not used downstream, stop as soon as enough objects pass the cuts
+   if (decisionOnly_) {
+     int n(0);
+     typename TCollection::const_iterator i ( objects->begin() );
+     for (; (n<min_N_) && (i!=objects->end()); i++) {
+       if ((*select_)(*i)) n++;
+     }
+     return (n>=min_N_);
+   }
+
+   // check the cut on all objects at once, and add the passing ones to filter object
+   select_->select(*objects, workspace_, pass_);
    int n(0);
-   typename TCollection::const_iterator i ( objects->begin() );
-   for (; i!=objects->end(); i++) {
-     if (select_(*i)) {
+   const unsigned int size(objects->size());
+   for (unsigned int i=0; i!=size; ++i) {
+     if (pass_[i]) {
        n++;
-       ref=TRef(objects,distance(objects->begin(),i));
+       ref=TRef(objects,i);
        filterproduct.addObject(triggerType_,ref);
      }
    }
@@ -21,15 +21,18 @@
 //
 HLTSummaryFilter::HLTSummaryFilter(const edm::ParameterSet& iConfig) : HLTFilter(iConfig),
   summaryTag_ (iConfig.getParameter<edm::InputTag>("summary")),
-  memberTag_  (iConfig.getParameter<edm::InputTag>("member" )),
+  member_     (iConfig.getParameter<edm::InputTag>("member" )),
   cut_        (iConfig.getParameter<std::string>  ("cut"    )),
   min_N_      (iConfig.getParameter<int>          ("minN"   )),
-  select_     (cut_                                          )
+  select_     (HLTCutSelector<trigger::TriggerObject>::get(cut_)),
+  columns_    (),
+  workspace_  (),
+  pass_       ()
 {
   edm::LogInfo("HLTSummaryFilter")
      << "Summary/member/cut/ncut : "
      << summaryTag_.encode() << " "
-     << memberTag_.encode() << " " 
+     << member_.tag().encode() << " " 
      << cut_<< " " << min_N_ ;
 }
 
@@ -60,37 +63,20 @@ HLTSummaryFilter::hltFilter(edm::Event& iEvent, const edm::EventSetup& iSetup, t
      return false;
    }
 
-   size_type n(0);
-   size_type index(0);
+   if (member_.find(*summary)) {
+     // columnar view of the trigger objects of this event
+     columns_.reset(summary->getObjects());
 
-   // check if we want to look at a filter and its passing physics objects
-   index=summary->filterIndex(memberTag_);
-   if (index<summary->sizeFilters()) {
-     const Keys& KEYS (summary->filterKeys(index));
-     const size_type n1(KEYS.size());
+     // check the cut on the passing physics objects of a filter, or on all physics objects of a full "L3" collection
+     member_.select(*summary,columns_,*select_,workspace_,pass_);
+     size_type n(0);
+     const size_type n1(pass_.size());
      for (size_type i=0; i!=n1; ++i) {
-       const TriggerObject& TO( summary->getObjects().at(KEYS[i]) );
-       if (select_(TO)) n++;
+       if (pass_[i]) n++;
      }
      const bool accept(n>=min_N_);
      LogInfo("HLTSummaryFilter")
-       << " Filter objects: " << n << "/" << n1;
-     return accept;
-   }
-   
-   // check if we want to cut on all physics objects of a full "L3" collection
-   index=summary->collectionIndex(memberTag_);
-   if (index<summary->sizeCollections()) {
-     const Keys& KEYS (summary->collectionKeys());
-     const size_type n0 (index == 0? 0 : KEYS.at(index-1));
-     const size_type n1 (KEYS.at(index));
-     for (size_type i=n0; i!=n1; ++i) {
-       const TriggerObject& TO( summary->getObjects().at(i) );
-       if (select_(TO)) n++;
-     }
-     const bool accept(n>=min_N_);
-     LogInfo("HLTSummaryFilter")
-       << " Collection objects: " << n << "/" <<n1-n0;
+       << (member_.filter() ? " Filter objects: " : " Collection objects: ") << n << "/" << n1;
      return accept;
    }
 
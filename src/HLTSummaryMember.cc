@@ -0,0 +1,72 @@
+/** \class HLTSummaryMember
+ *
+ * See header file for documentation
+ *
+ *  \author Martin Grunewald
+ *
+ */
+
+#include "HLTrigger/HLTfilters/interface/HLTSummaryMember.h"
+
+//
+// constructors and destructor
+//
+HLTSummaryMember::HLTSummaryMember(const edm::InputTag & tag) :
+  tag_     (tag),
+  encoded_ (tag.encode()),
+  found_   (false),
+  filter_  (false),
+  index_   (0)
+{
+}
+
+//
+// member functions
+//
+
+bool
+HLTSummaryMember::find(const trigger::TriggerEvent & summary)
+{
+   // check the filter position found in the previous event, which is valid as long as the summary layout does not change
+   if (found_ and filter_ and index_<summary.sizeFilters() and summary.filterTag(index_).encode()==encoded_)
+     return true;
+
+   // a filter takes precedence over a collection with the same tag, so it is always looked for first
+   trigger::size_type index(summary.filterIndex(tag_));
+   if (index<summary.sizeFilters()) {
+     found_=true;
+     filter_=true;
+     index_=index;
+     return true;
+   }
+
+   // then check the collection position found in the previous event, or look it up
+   if (found_ and not filter_ and index_<summary.sizeCollections() and summary.collectionTag(index_)==encoded_)
+     return true;
+   index=summary.collectionIndex(tag_);
+   if (index<summary.sizeCollections()) {
+     found_=true;
+     filter_=false;
+     index_=index;
+     return true;
+   }
+   found_=false;
+   return false;
+}
+
+void
+HLTSummaryMember::select(const trigger::TriggerEvent & summary, const HLTCutColumns<trigger::TriggerObject> & objects,
+                         const HLTCutSelector<trigger::TriggerObject> & selector,
+                         HLTCutExpression::Workspace & workspace, std::vector<unsigned char> & pass) const
+{
+   if (filter_) {
+     // the physics objects passing a filter
+     selector.select(objects,summary.filterKeys(index_),workspace,pass);
+   } else {
+     // all physics objects of a full "L3" collection
+     const trigger::Keys& KEYS (summary.collectionKeys());
+     const trigger::size_type n0 (index_ == 0? 0 : KEYS[index_-1]);
+     const trigger::size_type n1 (KEYS[index_]);
+     selector.select(objects,n0,n1,workspace,pass);
+   }
+}
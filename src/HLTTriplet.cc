@@ -0,0 +1,246 @@
+/** \class HLTTriplet
+ *
+ * See header file for documentation
+ *
+ *  \author Martin Grunewald
+ *
+ */
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "HLTrigger/HLTfilters/interface/HLTTriplet.h"
+
+#include "DataFormats/Common/interface/Handle.h"
+
+#include "DataFormats/Common/interface/Ref.h"
+#include "DataFormats/HLTReco/interface/TriggerFilterObjectWithRefs.h"
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include<cmath>
+
+//
+// constructors and destructor
+//
+template<typename T1, typename T2, typename T3>
+HLTTriplet<T1,T2,T3>::HLTTriplet(const edm::ParameterSet& iConfig) : HLTFilter(iConfig),
+  originTag1_(iConfig.template getParameter<edm::InputTag>("originTag1")),
+  originTag2_(iConfig.template getParameter<edm::InputTag>("originTag2")),
+  originTag3_(iConfig.template getParameter<edm::InputTag>("originTag3")),
+  inputTag1_(iConfig.template getParameter<edm::InputTag>("inputTag1")),
+  inputTag2_(iConfig.template getParameter<edm::InputTag>("inputTag2")),
+  inputTag3_(iConfig.template getParameter<edm::InputTag>("inputTag3")),
+  triggerType1_(iConfig.template getParameter<int>("triggerType1")),
+  triggerType2_(iConfig.template getParameter<int>("triggerType2")),
+  triggerType3_(iConfig.template getParameter<int>("triggerType3")),
+  cuts12_   (iConfig.template getParameter<edm::ParameterSet>("cuts12")),
+  cuts13_   (iConfig.template getParameter<edm::ParameterSet>("cuts13")),
+  cuts23_   (iConfig.template getParameter<edm::ParameterSet>("cuts23")),
+  min_Minv_ (iConfig.template getParameter<double>("MinMinv")),
+  max_Minv_ (iConfig.template getParameter<double>("MaxMinv")),
+  min_Pt_   (iConfig.template getParameter<double>("MinPt")),
+  max_Pt_   (iConfig.template getParameter<double>("MaxPt")),
+  min_N_    (iConfig.template getParameter<int>("MinN")),
+  decisionOnly_(iConfig.template getParameter<bool>("decisionOnly")),
+  coll1_(),
+  coll2_(),
+  coll3_(),
+  columns1_(),
+  columns2_(),
+  columns3_(),
+  pass13_(),
+  pass23_(),
+  done23_(),
+  collectionTags_(),
+  tags_()
+{
+   // same collections to be compared?
+   same12_ = (inputTag1_.encode()==inputTag2_.encode());
+   same13_ = (inputTag1_.encode()==inputTag3_.encode());
+   same23_ = (inputTag2_.encode()==inputTag3_.encode());
+
+   cutminv_ = (min_Minv_ <= max_Minv_); // cut active?
+   cutpt_   = (min_Pt_   <= max_Pt_  ); // cut active?
+
+   // the variables needed by the cuts
+   groups_ = cuts12_.groups() | cuts13_.groups() | cuts23_.groups();
+   if (cutminv_ || cutpt_) groups_ |= HLTObjectColumns::kMomentum;
+
+   LogDebug("") << "InputTags and cuts : "
+		<< inputTag1_.encode() << " " << inputTag2_.encode() << " " << inputTag3_.encode()
+		<< triggerType1_ << " " << triggerType2_ << " " << triggerType3_
+                << " Minv [" << min_Minv_ << " " << max_Minv_ << "]"
+                << " Pt   [" << min_Pt_   << " " << max_Pt_   << "]"
+                << " MinN =" << min_N_
+		<< " same12/same13/same23/minv/pt "
+		<< same12_ << same13_ << same23_
+		<< cutminv_ << cutpt_;
+}
+
+template<typename T1, typename T2, typename T3>
+HLTTriplet<T1,T2,T3>::~HLTTriplet()
+{
+}
+
+template<typename T1, typename T2, typename T3>
+void
+HLTTriplet<T1,T2,T3>::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  makeHLTFilterDescription(desc);
+  desc.add<edm::InputTag>("originTag1",edm::InputTag("hltOriginal1"));
+  desc.add<edm::InputTag>("originTag2",edm::InputTag("hltOriginal2"));
+  desc.add<edm::InputTag>("originTag3",edm::InputTag("hltOriginal3"));
+  desc.add<edm::InputTag>("inputTag1",edm::InputTag("hltFiltered1"));
+  desc.add<edm::InputTag>("inputTag2",edm::InputTag("hltFiltered2"));
+  desc.add<edm::InputTag>("inputTag3",edm::InputTag("hltFiltered3"));
+  desc.add<int>("triggerType1",0);
+  desc.add<int>("triggerType2",0);
+  desc.add<int>("triggerType3",0);
+  {
+    edm::ParameterSetDescription cuts;
+    HLTPairCuts::fillDescription(cuts);
+    desc.add<edm::ParameterSetDescription>("cuts12",cuts);
+    desc.add<edm::ParameterSetDescription>("cuts13",cuts);
+    desc.add<edm::ParameterSetDescription>("cuts23",cuts);
+  }
+  desc.add<double>("MinMinv",+1.0);
+  desc.add<double>("MaxMinv",-1.0);
+  desc.add<double>("MinPt"  ,+1.0);
+  desc.add<double>("MaxPt"  ,-1.0);
+  desc.add<int>("MinN",1);
+  desc.add<bool>("decisionOnly",false);
+  descriptions.add(std::string("hlt")+std::string(typeid(HLTTriplet<T1,T2,T3>).name()),desc);
+}
+
+//
+// member functions
+//
+
+// ------------ method called to produce the data  ------------
+template<typename T1, typename T2, typename T3>
+bool
+HLTTriplet<T1,T2,T3>::hltFilter(edm::Event& iEvent, const edm::EventSetup& iSetup, trigger::TriggerFilterObjectWithRefs & filterproduct)
+{
+   using namespace std;
+   using namespace edm;
+   using namespace reco;
+   using namespace trigger;
+
+   // All HLT filters must create and fill an HLT filter object,
+   // recording any reconstructed physics objects satisfying (or not)
+   // this HLT filter, and place it in the Event.
+
+   bool accept(false);
+
+   // get hold of pre-filtered object collections
+   Handle<TriggerFilterObjectWithRefs> coll1,coll2,coll3;
+   if (iEvent.getByLabel (inputTag1_,coll1) && iEvent.getByLabel (inputTag2_,coll2) && iEvent.getByLabel (inputTag3_,coll3)) {
+     coll1_.clear();
+     coll1->getObjects(triggerType1_,coll1_);
+     const size_type n1(coll1_.size());
+     coll2_.clear();
+     coll2->getObjects(triggerType2_,coll2_);
+     const size_type n2(coll2_.size());
+     coll3_.clear();
+     coll3->getObjects(triggerType3_,coll3_);
+     const size_type n3(coll3_.size());
+
+     if (saveTags()) {
+       addCollectionTags(iEvent,originTag1_,coll1_,1,filterproduct);
+       addCollectionTags(iEvent,originTag2_,coll2_,2,filterproduct);
+       addCollectionTags(iEvent,originTag3_,coll3_,3,filterproduct);
+     }
+
+     // resolve the Refs once, into contiguous arrays of the variables needed by the cuts
+     columns1_.fill(coll1_,groups_);
+     columns2_.fill(coll2_,groups_);
+     columns3_.fill(coll3_,groups_);
+
+     // the (2,3) pairs passing the cuts, as a n2 x n3 matrix whose rows are filled the first time they are needed
+     if (cuts23_.active()) {
+       pass23_.resize(n2*n3);
+       done23_.assign(n2,0);
+     }
+
+     int n(0);
+     // if the objects are not used downstream, stop as soon as enough triplets pass the cuts
+     for (unsigned int i1=0; (i1!=n1) && !(decisionOnly_ && n>=min_N_); i1++) {
+       const unsigned int I3(same13_ ? i1+1 : 0);
+       bool done13(false);
+
+       for (unsigned int i2=(same12_ ? i1+1 : 0); (i2<n2) && !(decisionOnly_ && n>=min_N_); i2++) {
+	 // prune on the (1,2) pair before looping on the 3rd objects
+	 if (not cuts12_(columns1_,i1,columns2_,i2)) continue;
+
+	 // the (1,3) pairs passing the cuts, once for all the 2nd objects
+	 if (cuts13_.active() && not done13) {
+	   pass13_.resize(n3);
+	   for (unsigned int i3=I3; i3<n3; i3++)
+	     pass13_[i3] = cuts13_(columns1_,i1,columns3_,i3);
+	   done13 = true;
+	 }
+
+	 // the (2,3) pairs passing the cuts, once for all the 1st objects
+	 if (cuts23_.active() && not done23_[i2]) {
+	   for (unsigned int i3=(same23_ ? i2+1 : 0); i3<n3; i3++)
+	     pass23_[i2*n3+i3] = cuts23_(columns2_,i2,columns3_,i3);
+	   done23_[i2] = 1;
+	 }
+
+	 for (unsigned int i3=(same23_ && i2+1>I3 ? i2+1 : I3); i3<n3; i3++) {
+	   if (cuts13_.active() && not pass13_[i3]) continue;
+	   if (cuts23_.active() && not pass23_[i2*n3+i3]) continue;
+	   if (not selectTriplet(i1,i2,i3)) continue;
+	   n++;
+	   if (decisionOnly_) {
+	     if (n>=min_N_) break;
+	     continue;
+	   }
+	   filterproduct.addObject(triggerType1_,coll1_[i1]);
+	   filterproduct.addObject(triggerType2_,coll2_[i2]);
+	   filterproduct.addObject(triggerType3_,coll3_[i3]);
+	 }
+       }
+     }
+     // filter decision
+     accept = (n>=min_N_);
+   }
+
+   return accept;
+}
+
+// ------------ check the three-body cuts on a triplet ------------
+template<typename T1, typename T2, typename T3>
+bool
+HLTTriplet<T1,T2,T3>::selectTriplet(unsigned int i1, unsigned int i2, unsigned int i3) const
+{
+   if (not (cutpt_ || cutminv_)) return true;
+
+   const double px(columns1_.px[i1]+columns2_.px[i2]+columns3_.px[i3]);
+   const double py(columns1_.py[i1]+columns2_.py[i2]+columns3_.py[i3]);
+   if (cutpt_) {
+     const double Pt(std::sqrt(px*px+py*py));
+     if (!((min_Pt_<=Pt) && (Pt<=max_Pt_))) return false;
+   }
+   if (cutminv_) {
+     const double pz(columns1_.pz[i1]+columns2_.pz[i2]+columns3_.pz[i3]);
+     const double E (columns1_.energy[i1]+columns2_.energy[i2]+columns3_.energy[i3]);
+     const double Minv(std::sqrt(std::abs(E*E-px*px-py*py-pz*pz)));
+     if (!((min_Minv_<=Minv) && (Minv<=max_Minv_))) return false;
+   }
+   return true;
+}
+
+// ------------ add the tags of the original and filtered collection of one input ------------
+template<typename T1, typename T2, typename T3>
+template<typename R>
+void
+HLTTriplet<T1,T2,T3>::addCollectionTags(const edm::Event & iEvent, const edm::InputTag & originTag, const std::vector<R> & refs, int index, trigger::TriggerFilterObjectWithRefs & filterproduct)
+{
+   filterproduct.addCollectionTag(originTag);
+   LogDebug("HLTTriplet") << "input " << index << ": original collection " << originTag.encode();
+   collectionTags_.tags(iEvent,refs,tags_);
+   for (unsigned int i=0; i!=tags_.size(); ++i) {
+     filterproduct.addCollectionTag(tags_[i]);
+     LogDebug("HLTTriplet") << "input " << index << ": filtered collection " << tags_[i].encode();
+   }
+}
@@ -0,0 +1,98 @@
+/** \class TriggerBitFilter
+ *
+ * See header file for documentation
+ *
+ *  Authors: Martin Grunewald, Andrea Bocci
+ *
+ */
+
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "DataFormats/Common/interface/Handle.h"
+#include "FWCore/Framework/interface/Run.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+
+#include "HLTrigger/HLTfilters/interface/TriggerBitFilter.h"
+
+//
+// constructors and destructor
+//
+TriggerBitFilter::TriggerBitFilter(const edm::ParameterSet & config) :
+  m_bits(  config.getParameter<edm::InputTag>("bits") ),
+  m_bit(   config.getParameter<std::string>("bit") ),
+  m_throw( config.getParameter<bool>("throw") ),
+  m_run(),
+  m_index( (unsigned int) -1 )
+{
+}
+
+TriggerBitFilter::~TriggerBitFilter()
+{
+}
+
+void
+TriggerBitFilter::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("bits",edm::InputTag("triggerResultsBits"));
+  desc.add<std::string>("bit","");
+  desc.add<bool>("throw",true);
+  descriptions.add("triggerBitFilter",desc);
+}
+
+//
+// member functions
+//
+
+void TriggerBitFilter::init(const edm::Run & run)
+{
+  m_index = (unsigned int) -1;
+
+  edm::Handle<std::vector<std::string> > names;
+  run.getByLabel(m_bits, names);
+  if (names.isValid()) {
+    std::vector<std::string>::const_iterator name = std::find(names->begin(), names->end(), m_bit);
+    if (name != names->end())
+      m_index = name - names->begin();
+  }
+
+  if (m_index == (unsigned int) -1) {
+    if (m_throw)
+      throw cms::Exception("Configuration") << "requested bit \"" << m_bit << "\" does not exist in " << m_bits.encode();
+    else
+      edm::LogInfo("Configuration") << "requested bit \"" << m_bit << "\" does not exist in " << m_bits.encode();
+  }
+}
+
+// ------------ method called to produce the data  ------------
+bool
+TriggerBitFilter::filter(edm::Event & event, const edm::EventSetup & setup)
+{
+  // the names are only guaranteed to be available once all the beginRun transitions have taken place,
+  // so look them up lazily, during the first event of each Run
+  if (m_run != event.getRun().id()) {
+    m_run = event.getRun().id();
+    init(event.getRun());
+  }
+
+  if (m_index == (unsigned int) -1)
+    // unknown bit
+    return false;
+
+  edm::Handle<std::vector<bool> > bits;
+  event.getByLabel(m_bits, bits);
+  if (not bits.isValid()) {
+    edm::LogError("TriggerBitFilter") << "bits product " << m_bits.encode() << " not found - returning result=false!";
+    return false;
+  }
+
+  return m_index < bits->size() and (*bits)[m_index];
+}
+
+// register as framework plugin
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE(TriggerBitFilter);
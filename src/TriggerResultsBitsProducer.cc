@@ -0,0 +1,112 @@
+/** \class TriggerResultsBitsProducer
+ *
+ * See header file for documentation
+ *
+ *  Authors: Martin Grunewald, Andrea Bocci
+ *
+ */
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <memory>
+#include <boost/foreach.hpp>
+
+#include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include "HLTrigger/HLTcore/interface/TriggerExpressionEvaluator.h"
+#include "HLTrigger/HLTcore/interface/TriggerExpressionParser.h"
+#include "HLTrigger/HLTfilters/interface/TriggerResultsBitsProducer.h"
+
+//
+// constructors and destructor
+//
+TriggerResultsBitsProducer::TriggerResultsBitsProducer(const edm::ParameterSet & config) :
+  m_names(),
+  m_expressions(),
+  m_eventCache(config)
+{
+  const edm::ParameterSet & conditions = config.getParameter<edm::ParameterSet>("triggerConditions");
+  m_names = conditions.getParameterNamesForType<std::vector<std::string> >();
+  if (m_names.empty())
+    edm::LogWarning("Configuration") << "Empty list of trigger conditions";
+
+  m_expressions.reserve(m_names.size());
+  BOOST_FOREACH(const std::string & name, m_names)
+    m_expressions.push_back( parse( name, conditions.getParameter<std::vector<std::string> >(name) ) );
+
+  produces<std::vector<bool> >();
+  produces<std::vector<std::string>, edm::InRun>();
+}
+
+TriggerResultsBitsProducer::~TriggerResultsBitsProducer()
+{
+  BOOST_FOREACH(triggerExpression::Evaluator * expression, m_expressions)
+    delete expression;
+}
+
+triggerExpression::Evaluator * TriggerResultsBitsProducer::parse(const std::string & name, const std::vector<std::string> & expressions) const {
+  // parse the logical expressions into functionals
+  if (expressions.size() == 0) {
+    edm::LogWarning("Configuration") << "Empty trigger results expression for \"" << name << "\"";
+    return 0;
+  } else if (expressions.size() == 1) {
+    return parse( name, expressions[0] );
+  } else {
+    std::stringstream expression;
+    expression << "(" << expressions[0] << ")";
+    for (unsigned int i = 1; i < expressions.size(); ++i)
+      expression << " OR (" << expressions[i] << ")";
+    return parse( name, expression.str() );
+  }
+}
+
+triggerExpression::Evaluator * TriggerResultsBitsProducer::parse(const std::string & name, const std::string & expression) const {
+  // parse the logical expressions into functionals
+  triggerExpression::Evaluator * evaluator = triggerExpression::parse( expression );
+
+  // check if the expressions were parsed correctly
+  if (not evaluator)
+    edm::LogWarning("Configuration") << "Couldn't parse trigger results expression \"" << expression << "\" for \"" << name << "\"";
+
+  return evaluator;
+}
+
+void TriggerResultsBitsProducer::beginRun(edm::Run & run, const edm::EventSetup & setup)
+{
+  // store the names of the trigger conditions, so the bits can be looked up by name
+  std::auto_ptr<std::vector<std::string> > names( new std::vector<std::string>(m_names) );
+  run.put(names);
+}
+
+void TriggerResultsBitsProducer::produce(edm::Event & event, const edm::EventSetup & setup)
+{
+  const unsigned int size = m_expressions.size();
+  std::auto_ptr<std::vector<bool> > bits( new std::vector<bool>(size, false) );
+
+  // if the Event cannot be properly accessed, all conditions are considered as failed
+  if (m_eventCache.setEvent(event, setup)) {
+    // if the L1 or HLT configurations have changed, (re)initialize the filters (including during the first event)
+    if (m_eventCache.configurationUpdated()) {
+      for (unsigned int i = 0; i < size; ++i)
+        if (m_expressions[i]) {
+          m_expressions[i]->init(m_eventCache);
+
+          // log the expanded configuration
+          edm::LogInfo("Configuration") << "TriggerResultsBitsProducer configuration updated for \"" << m_names[i] << "\": " << *m_expressions[i];
+        }
+    }
+
+    // evaluate all the trigger conditions on the same cached event data
+    for (unsigned int i = 0; i < size; ++i)
+      if (m_expressions[i])
+        (*bits)[i] = (*m_expressions[i])(m_eventCache);
+  }
+
+  event.put(bits);
+}
+
+// register as framework plugin
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE(TriggerResultsBitsProducer);
@@ -0,0 +1,186 @@
+/** \file testHLTCutSelector.cpp
+ *
+ *  Checks that the cuts compiled by HLTCutSelector take the same decisions
+ *  as StringCutObjectSelector, both for single objects and for a whole
+ *  collection, and that the cuts it can not compile fall back to it.
+ *
+ *  \author Martin Grunewald
+ *
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+#include <vector>
+#include <sstream>
+
+#include "FWCore/Utilities/interface/Exception.h"
+#include "DataFormats/Candidate/interface/LeafCandidate.h"
+#include "CommonTools/Utils/interface/StringCutObjectSelector.h"
+#include "HLTrigger/HLTfilters/interface/HLTCutSelector.h"
+
+class testHLTCutSelector : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testHLTCutSelector);
+  CPPUNIT_TEST(checkDecisions);
+  CPPUNIT_TEST(checkShared);
+  CPPUNIT_TEST(checkRejected);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp() {}
+  void tearDown() {}
+  void checkDecisions();
+  void checkShared();
+  void checkRejected();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testHLTCutSelector);
+
+namespace {
+
+  // a cut, and whether HLTCutSelector is expected to compile it
+  struct Cut {
+    const char * cut;
+    bool         compiled;
+  };
+
+  const Cut cuts[] = {
+    // empty cut, constants and numerical values used as conditions
+    { "",                                               true  },
+    { "5 > 3",                                          true  },
+    { "0",                                              true  },
+    { "pt",                                             true  },
+    { "pt - 20",                                        true  },
+    // comparisons, also chained
+    { "pt > 15",                                        true  },
+    { "pt>=15",                                         true  },
+    { "eta <= 0",                                       true  },
+    { "charge == -1",                                   true  },
+    { "charge = -1",                                    true  },
+    { "charge != 0",                                    true  },
+    { "-2.5 < eta < 2.5",                               true  },
+    { "-1 < eta < 1 && 5 < pt < 100",                   true  },
+    { "pt > 15 && -2.5 < eta < 2.5",                    true  },
+    // logical operators and their precedence
+    { "abs(eta) < 2.1 || pt > 40",                      true  },
+    { "pt > 10 && eta > 0 || phi < 0",                  true  },
+    { "pt > 10 && (eta > 0 || phi < 0)",                true  },
+    { "charge == -1 & pt > 5",                          true  },
+    { "charge != 0 | mass > 1",                         true  },
+    { "!(pt > 20)",                                     true  },
+    { "!(pt > 20) && !(eta < 0)",                       true  },
+    // arithmetic, precedence and associativity
+    { "1 + 2 * 3 == 7",                                 true  },
+    { "(1 + 2) * 3 == 9",                               true  },
+    { "10 / 4 == 2.5",                                  true  },
+    { "10 - 4 - 3 == 3",                                true  },
+    { "2^3^2 == 64",                                    true  },
+    { "-2^2 == 4",                                      true  },
+    { "-pt^2 < -100",                                   true  },
+    { "pt^2 > 400",                                     true  },
+    { "-eta > 0",                                       true  },
+    { "+eta > 0",                                       true  },
+    // functions
+    { "sqrt(px^2 + py^2) > 15",                         true  },
+    { "log(pt) > 2 && log10(energy) < 2",               true  },
+    { "exp(-eta) > 1",                                  true  },
+    { "sin(phi) > 0 || cos(phi) > 0.5 || tan(phi) < -1",true  },
+    { "asin(0.5) < acos(0.5) && atan(eta) > 0",         true  },
+    { "sinh(eta) > 0.5 || cosh(eta) > 2 || tanh(eta) < -0.5", true },
+    { "atan2(py, px) > 0",                              true  },
+    { "hypot(px, py) > 15",                             true  },
+    { "min(pt, energy) > 10 && max(abs(eta), 1) == 1",  true  },
+    { "pow(pt, 2) > 100",                               true  },
+    // accessors, with and without parentheses
+    { "et() > 10 && mass() < 5",                        true  },
+    { "massSqr > 1 || mt > 20",                         true  },
+    { "p > 30 && pz < 0",                               true  },
+    { "theta < 1 || rapidity > 0 || y < -1",            true  },
+    { "pdgId == 13 && vz < 1 && vz > -1",               true  },
+    { "vx < 0.1 && vy > -0.1",                          true  },
+    // methods not handled by the compiled cuts fall back to StringCutObjectSelector
+    { "numberOfDaughters == 0",                         false },
+    { "pt > 10 && numberOfDaughters() == 0",            false },
+    { "p4.pt > 15",                                     false },
+    { "status == 0",                                    false },
+    // more variables than HLTCutExpression::kMaxVariables
+    { "energy + et + mass + massSqr + mt + p + pt + px + py + pz + eta + phi + theta + rapidity + charge + pdgId + vx > 0", false },
+  };
+
+  // a cut needing a deeper stack than HLTCutExpression::kMaxDepth
+  std::string deepCut() {
+    std::ostringstream cut;
+    for (unsigned int i = 0; i != 40; ++i)
+      cut << "1 + (";
+    cut << "pt";
+    for (unsigned int i = 0; i != 40; ++i)
+      cut << ")";
+    cut << " > 50";
+    return cut.str();
+  }
+
+  std::vector<reco::LeafCandidate> candidates() {
+    typedef reco::LeafCandidate::PolarLorentzVector P4;
+    typedef reco::LeafCandidate::Point Point;
+    std::vector<reco::LeafCandidate> objects;
+    objects.push_back(reco::LeafCandidate(-1, P4( 25.,  1.2,  0.5, 0.106), Point( 0.01, -0.02,  0.5), 13));
+    objects.push_back(reco::LeafCandidate(+1, P4( 12., -2.3, -2.9, 0.106), Point(-0.05,  0.03, -1.5), -13));
+    objects.push_back(reco::LeafCandidate( 0, P4( 45.,  0.1,  3.1, 0.),    Point( 0.,    0.,    0.1), 22));
+    objects.push_back(reco::LeafCandidate( 0, P4(  3., -0.7,  1.6, 1.5),   Point( 0.2,  -0.1,   3.0), 111));
+    objects.push_back(reco::LeafCandidate(-1, P4(150.,  4.5, -0.3, 80.4),  Point( 0.,    0.,   -0.2), -24));
+    return objects;
+  }
+
+  void check(const std::string & cut, bool compiled, const std::vector<reco::LeafCandidate> & objects) {
+    const HLTCutSelector<reco::LeafCandidate> selector(cut);
+    const StringCutObjectSelector<reco::LeafCandidate,true> reference(cut);
+    const std::string message("cut \"" + cut + "\"");
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(message + ": compiled", compiled, selector.compiled());
+
+    HLTCutExpression::Workspace workspace;
+    std::vector<unsigned char> pass;
+    selector.select(objects, workspace, pass);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(message + ": size", objects.size(), pass.size());
+
+    for (unsigned int i = 0; i != objects.size(); ++i) {
+      std::ostringstream object;
+      object << ", object " << i;
+      const bool expected = reference(objects[i]);
+      CPPUNIT_ASSERT_EQUAL_MESSAGE(message + object.str(), expected, selector(objects[i]));
+      CPPUNIT_ASSERT_EQUAL_MESSAGE(message + object.str() + " (collection)", expected, bool(pass[i]));
+    }
+  }
+
+}
+
+void testHLTCutSelector::checkDecisions() {
+  const std::vector<reco::LeafCandidate> objects = candidates();
+  for (unsigned int i = 0; i != sizeof(cuts) / sizeof(Cut); ++i)
+    check(cuts[i].cut, cuts[i].compiled, objects);
+  check(deepCut(), false, objects);
+}
+
+void testHLTCutSelector::checkShared() {
+  // cuts differing only by the amount of whitespace share the same selector
+  const boost::shared_ptr<const HLTCutSelector<reco::LeafCandidate> > a = HLTCutSelector<reco::LeafCandidate>::get("pt > 15 && abs(eta) < 2.5");
+  const boost::shared_ptr<const HLTCutSelector<reco::LeafCandidate> > b = HLTCutSelector<reco::LeafCandidate>::get("  pt >  15 &&\tabs(eta) <   2.5 ");
+  const boost::shared_ptr<const HLTCutSelector<reco::LeafCandidate> > c = HLTCutSelector<reco::LeafCandidate>::get("pt>20");
+  CPPUNIT_ASSERT(a == b);
+  CPPUNIT_ASSERT(a != c);
+
+  // whitespace separating two tokens is never removed
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("normalize", std::string("pt > 15 && abs(eta) < 2.5"), HLTCutExpression::normalize(" pt  > 15 &&\tabs(eta) <\n2.5  "));
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("normalize", std::string("pt < = 3"), HLTCutExpression::normalize("pt < = 3"));
+  CPPUNIT_ASSERT(HLTCutExpression::normalize("pt < = 3") != HLTCutExpression::normalize("pt<=3"));
+}
+
+void testHLTCutSelector::checkRejected() {
+  // chains of more than two comparisons are not compiled, and the fallback rejects them as StringCutObjectSelector does
+  const std::string cut("-1 < eta < 1 < pt");
+  CPPUNIT_ASSERT(not HLTCutExpression(cut).valid());
+  CPPUNIT_ASSERT_THROW((StringCutObjectSelector<reco::LeafCandidate,true>(cut)), cms::Exception);
+  CPPUNIT_ASSERT_THROW((HLTCutSelector<reco::LeafCandidate>(cut)), cms::Exception);
+}
+
+#include "Utilities/Testing/interface/CppUnit_testdriver.icpp"
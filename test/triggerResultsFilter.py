@@ -134,6 +134,37 @@ process.filter_false_pattern = hlt.triggerResultsFilter.clone(
 )
 
 
+# evaluate several conditions at once, and select on the individual results
+import HLTrigger.HLTfilters.triggerResultsBitsProducer_cfi as bits
+process.triggerResultsBits = bits.triggerResultsBits.clone(
+    l1tResults = '',
+    throw = False,
+    triggerConditions = cms.PSet(
+        Path_1      = cms.vstring( 'HLT_Path_1', ),
+        Path_1_pre  = cms.vstring( '(HLT_Path_1) / 15', ),
+        Path_any_or = cms.vstring( 'HLT_Path_1', 'HLT_Path_2', 'HLT_Path_3' ),
+        Wrong_name  = cms.vstring( 'HLT_Wrong', )
+    )
+)
+
+# accept if 'HLT_Path_1' succeeds, from the precomputed bits
+process.filter_bit_1 = cms.EDFilter('TriggerBitFilter',
+    bits  = cms.InputTag('triggerResultsBits'),
+    bit   = cms.string('Path_1'),
+    throw = cms.bool(True)
+)
+
+# accept if any path succeeds, from the precomputed bits
+process.filter_bit_any_or = process.filter_bit_1.clone(
+    bit = 'Path_any_or'
+)
+
+# wrong path name, from the precomputed bits
+process.filter_bit_wrong_name = process.filter_bit_1.clone(
+    bit = 'Wrong_name'
+)
+
+
 process.path_1 = cms.Path( process.filter_1 )
 process.path_2 = cms.Path( process.filter_2 )
 process.path_3 = cms.Path( process.filter_3 )
@@ -156,6 +187,10 @@ process.path_empty_pattern       = cms.Path( process.filter_empty_pattern )
 process.path_true_pattern        = cms.Path( process.filter_true_pattern )
 process.path_false_pattern       = cms.Path( process.filter_false_pattern )
 
+process.path_bit_1          = cms.Path( process.triggerResultsBits + process.filter_bit_1 )
+process.path_bit_any_or     = cms.Path( process.triggerResultsBits + process.filter_bit_any_or )
+process.path_bit_wrong_name = cms.Path( process.triggerResultsBits + process.filter_bit_wrong_name )
+
 # define an EndPath to analyze all other path results
 process.hltTrigReport = cms.EDAnalyzer( 'HLTrigReport',
     HLTriggerResults = cms.InputTag( 'TriggerResults','','TEST' )